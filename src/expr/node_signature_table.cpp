@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A hash-based signature table for Nodes and TNodes.
+ */
+
+#include "expr/node_signature_table.h"
+
+#include <algorithm>
+
+#include "util/hash.h"
+
+namespace cvc5 {
+namespace theory {
+
+template <bool ref_count>
+size_t NodeTemplateSignatureTable<ref_count>::hashSignature(
+    const NodeT& op, const std::vector<NodeT>& reps)
+{
+  uint64_t hash = fnv1a::fnv1a_64(op.getId());
+  for (const NodeT& r : reps)
+  {
+    hash = fnv1a::fnv1a_64(r.getId(), hash);
+  }
+  return static_cast<size_t>(hash);
+}
+
+template <bool ref_count>
+size_t NodeTemplateSignatureTable<ref_count>::find(
+    size_t hash, const NodeT& op, const std::vector<NodeT>& reps) const
+{
+  if (d_slots.empty())
+  {
+    return s_notFound;
+  }
+  size_t mask = d_slots.size() - 1;
+  for (size_t pos = hash & mask; d_slots[pos] != 0; pos = (pos + 1) & mask)
+  {
+    size_t i = d_slots[pos] - 1;
+    if (d_hashes[i] != hash || d_ops[i] != op
+        || d_argStart[i + 1] - d_argStart[i] != reps.size())
+    {
+      continue;
+    }
+    if (std::equal(reps.begin(), reps.end(), d_args.begin() + d_argStart[i]))
+    {
+      return i;
+    }
+  }
+  return s_notFound;
+}
+
+template <bool ref_count>
+void NodeTemplateSignatureTable<ref_count>::insertSlot(size_t i)
+{
+  size_t mask = d_slots.size() - 1;
+  size_t pos = d_hashes[i] & mask;
+  while (d_slots[pos] != 0)
+  {
+    pos = (pos + 1) & mask;
+  }
+  d_slots[pos] = i + 1;
+}
+
+template <bool ref_count>
+NodeTemplate<ref_count> NodeTemplateSignatureTable<ref_count>::existsTerm(
+    const NodeT& op, const std::vector<NodeT>& reps) const
+{
+  size_t i = find(hashSignature(op, reps), op, reps);
+  if (i == s_notFound)
+  {
+    return NodeT::null();
+  }
+  return d_terms[i];
+}
+
+template <bool ref_count>
+NodeTemplate<ref_count> NodeTemplateSignatureTable<ref_count>::addOrGetTerm(
+    const NodeT& n, const NodeT& op, const std::vector<NodeT>& reps)
+{
+  size_t hash = hashSignature(op, reps);
+  size_t i = find(hash, op, reps);
+  if (i != s_notFound)
+  {
+    return d_terms[i];
+  }
+  if (d_argStart.empty())
+  {
+    d_argStart.push_back(0);
+  }
+  size_t index = d_terms.size();
+  d_hashes.push_back(hash);
+  if (2 * (index + 1) > d_slots.size())
+  {
+    // grow the table and reinsert all entries
+    d_slots.assign(std::max(s_minSlots, 2 * d_slots.size()), 0);
+    for (size_t j = 0; j < index; j++)
+    {
+      insertSlot(j);
+    }
+  }
+  insertSlot(index);
+  d_ops.push_back(op);
+  d_args.insert(d_args.end(), reps.begin(), reps.end());
+  d_argStart.push_back(d_args.size());
+  d_terms.push_back(n);
+  return n;
+}
+
+template <bool ref_count>
+void NodeTemplateSignatureTable<ref_count>::clear()
+{
+  std::fill(d_slots.begin(), d_slots.end(), 0);
+  d_hashes.clear();
+  d_ops.clear();
+  d_args.clear();
+  d_argStart.clear();
+  d_terms.clear();
+}
+
+template class NodeTemplateSignatureTable<false>;
+template class NodeTemplateSignatureTable<true>;
+
+}  // namespace theory
+}  // namespace cvc5
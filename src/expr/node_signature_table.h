@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A hash-based signature table for Nodes and TNodes.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_SIGNATURE_TABLE_H
+#define CVC5__EXPR__NODE_SIGNATURE_TABLE_H
+
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+
+/** NodeTemplate signature table class
+ *
+ * This maps signatures, i.e. an operator together with a list of
+ * (representative) arguments, to terms. It serves the same purpose as a
+ * NodeTemplateTrie used as a signature table for congruence detection, but
+ * does not support traversing the terms by their arguments. In exchange,
+ * lookups amount to a single hash computation, and all signatures are stored
+ * in flat arrays instead of one std::map per argument. The signatures are
+ * indexed by an open-addressing hash table with linear probing. Clearing the
+ * table keeps the memory of all arrays, so that refilling it, e.g. in every
+ * round of the term database, does not allocate.
+ *
+ * For example, after adding f(d, c) with signature (f, a, c) and g(b) with
+ * signature (g, b), existsTerm(f, {a, c}) returns f(d, c) and existsTerm(g,
+ * {a}) returns null.
+ */
+template <bool ref_count>
+class NodeTemplateSignatureTable
+{
+  using NodeT = NodeTemplate<ref_count>;
+
+ public:
+  /**
+   * Returns the term with signature (op, reps), if one exists, or returns
+   * null otherwise.
+   */
+  NodeT existsTerm(const NodeT& op, const std::vector<NodeT>& reps) const;
+  /**
+   * Returns the term that was previously added with signature (op, reps), if
+   * one exists, or adds n with this signature and returns n.
+   */
+  NodeT addOrGetTerm(const NodeT& n,
+                     const NodeT& op,
+                     const std::vector<NodeT>& reps);
+  /** Clear all data from this table. */
+  void clear();
+  /** Get the number of terms in this table. */
+  size_t size() const { return d_terms.size(); }
+  /** Is this table empty? */
+  bool empty() const { return d_terms.empty(); }
+
+ private:
+  /** Computes the hash value of signature (op, reps). */
+  static size_t hashSignature(const NodeT& op, const std::vector<NodeT>& reps);
+  /** Returns the index of the entry with signature (op, reps), if any. */
+  size_t find(size_t hash, const NodeT& op, const std::vector<NodeT>& reps)
+      const;
+  /** Insert the index of entry i, whose hash is d_hashes[i], into d_slots */
+  void insertSlot(size_t i);
+  /** Marks that no entry was found */
+  static constexpr size_t s_notFound = static_cast<size_t>(-1);
+  /** The initial number of slots */
+  static constexpr size_t s_minSlots = 16;
+  /**
+   * The slots of the hash table, whose number is a power of two, and which
+   * contain the index of an entry plus one, or zero if they are empty. At
+   * most half of the slots are used.
+   */
+  std::vector<size_t> d_slots;
+  /** The hash value of the signature of each entry */
+  std::vector<size_t> d_hashes;
+  /** The operator of each entry */
+  std::vector<NodeT> d_ops;
+  /** The arguments of all entries, concatenated */
+  std::vector<NodeT> d_args;
+  /** The start index of the arguments of each entry in d_args */
+  std::vector<size_t> d_argStart;
+  /** The term of each entry */
+  std::vector<NodeT> d_terms;
+}; /* class NodeTemplateSignatureTable */
+
+/** Reference-counted version of the above data structure */
+typedef NodeTemplateSignatureTable<true> NodeSignatureTable;
+/** Non-reference-counted version of the above data structure */
+typedef NodeTemplateSignatureTable<false> TNodeSignatureTable;
+
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__EXPR__NODE_SIGNATURE_TABLE_H */
@@ -15,6 +15,8 @@
 
 #include "proof/proof_checker.h"
 
+#include <optional>
+
 #include "expr/skolem_manager.h"
 #include "options/proof_options.h"
 #include "proof/proof_node.h"
@@ -86,10 +88,31 @@ ProofCheckerStatistics::ProofCheckerStatistics()
 {
 }
 
+TimerStat& ProofCheckerStatistics::getRuleTime(PfRule id)
+{
+  size_t i = static_cast<size_t>(id);
+  if (i >= d_ruleTimes.size())
+  {
+    d_ruleTimes.resize(static_cast<size_t>(PfRule::UNKNOWN) + 1);
+  }
+  if (d_ruleTimes[i] == nullptr)
+  {
+    std::stringstream ss;
+    ss << "ProofCheckerStatistics::ruleTime::" << id;
+    d_ruleTimes[i] = std::make_unique<TimerStat>(
+        smtStatisticsRegistry().registerTimer(ss.str()));
+  }
+  return *d_ruleTimes[i];
+}
+
 ProofChecker::ProofChecker(bool eagerCheck,
                            uint32_t pclevel,
-                           rewriter::RewriteDb* rdb)
-    : d_eagerCheck(eagerCheck), d_pclevel(pclevel), d_rdb(rdb)
+                           rewriter::RewriteDb* rdb,
+                           bool timeRules)
+    : d_eagerCheck(eagerCheck),
+      d_pclevel(pclevel),
+      d_rdb(rdb),
+      d_timeRules(timeRules)
 {
 }
 
@@ -115,6 +138,11 @@ Node ProofChecker::check(
   // record stat
   d_stats.d_ruleChecks << id;
   ++d_stats.d_totalRuleChecks;
+  std::optional<CodeTimer> ruleTimer;
+  if (d_timeRules)
+  {
+    ruleTimer.emplace(d_stats.getRuleTime(id), true);
+  }
   Trace("pfcheck") << "ProofChecker::check: " << id << std::endl;
   std::vector<Node> cchildren;
   for (const std::shared_ptr<ProofNode>& pc : children)
@@ -19,6 +19,8 @@
 #define CVC5__PROOF__PROOF_CHECKER_H
 
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "expr/node.h"
 #include "proof/proof_rule.h"
@@ -95,10 +97,19 @@ class ProofCheckerStatistics
 {
  public:
   ProofCheckerStatistics();
+  /** Get the timer for the checks of proof rule id */
+  TimerStat& getRuleTime(PfRule id);
   /** Counts the number of checks for each kind of proof rule */
   HistogramStat<PfRule> d_ruleChecks;
   /** Total number of rule checks */
   IntStat d_totalRuleChecks;
+
+ private:
+  /**
+   * The time spent checking each kind of proof rule, indexed by rule and
+   * registered lazily
+   */
+  std::vector<std::unique_ptr<TimerStat>> d_ruleTimes;
 };
 
 /** A class for checking proofs */
@@ -107,7 +118,8 @@ class ProofChecker
  public:
   ProofChecker(bool eagerCheck,
                uint32_t pclevel = 0,
-               rewriter::RewriteDb* rdb = nullptr);
+               rewriter::RewriteDb* rdb = nullptr,
+               bool timeRules = false);
   ~ProofChecker() {}
   /**
    * Return the formula that is proven by proof node pn, or null if pn is not
@@ -197,6 +209,8 @@ class ProofChecker
   uint32_t d_pclevel;
   /** Pointer to the rewrite database */
   rewriter::RewriteDb* d_rdb;
+  /** Whether we time the checks of each proof rule */
+  bool d_timeRules;
   /**
    * Check internal. This is used by check and checkDebug above. It writes
    * checking errors on out when enableOutput is true. We treat trusted checkers
@@ -23,7 +23,7 @@ namespace cvc5 {
 ProofNode::ProofNode(PfRule id,
                      const std::vector<std::shared_ptr<ProofNode>>& children,
                      const std::vector<Node>& args)
-    : d_provenChecked(false)
+    : d_provenChecked(false), d_isShared(false)
 {
   setValue(id, children, args);
 }
@@ -18,6 +18,8 @@
 #ifndef CVC5__PROOF__PROOF_NODE_H
 #define CVC5__PROOF__PROOF_NODE_H
 
+#include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "expr/node.h"
@@ -125,6 +127,14 @@ class ProofNode
   Node d_proven;
   /** Was d_proven actually checked, or is it trusted? */
   bool d_provenChecked;
+  /** Was this node returned more than once by ProofNodeManager::mkNode? */
+  bool d_isShared;
+  /**
+   * The free assumptions of this node when it was first updated after being
+   * shared, which is allocated only for such nodes. Updates of shared nodes
+   * never add free assumptions, hence this includes its free assumptions.
+   */
+  std::unique_ptr<std::unordered_set<Node>> d_sharedAssumps;
 };
 
 inline size_t ProofNodeHashFunction::operator()(
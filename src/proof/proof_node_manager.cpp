@@ -15,6 +15,7 @@
 
 #include "proof/proof_node_manager.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "options/proof_options.h"
@@ -22,7 +23,9 @@
 #include "proof/proof_checker.h"
 #include "proof/proof_node.h"
 #include "proof/proof_node_algorithm.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/rewriter.h"
+#include "util/hash.h"
 
 using namespace cvc5::kind;
 
@@ -31,7 +34,20 @@ namespace cvc5 {
 ProofNodeManager::ProofNodeManager(const Options& opts,
                                    theory::Rewriter* rr,
                                    ProofChecker* pc)
-    : d_opts(opts), d_rewriter(rr), d_checker(pc)
+    : d_opts(opts),
+      d_rewriter(rr),
+      d_checker(pc),
+      d_storeSize(0),
+      d_nodesCreated(smtStatisticsRegistry().registerInt(
+          "ProofNodeManager::nodesCreated")),
+      d_nodesShared(smtStatisticsRegistry().registerInt(
+          "ProofNodeManager::nodesShared")),
+      d_bytesSaved(
+          smtStatisticsRegistry().registerInt("ProofNodeManager::bytesSaved")),
+      d_sharedRules(smtStatisticsRegistry().registerHistogram<PfRule>(
+          "ProofNodeManager::sharedRules")),
+      d_sharedUpdatesRejected(smtStatisticsRegistry().registerInt(
+          "ProofNodeManager::sharedUpdatesRejected"))
 {
   d_true = NodeManager::currentNM()->mkConst(true);
   // we always allocate a proof checker, regardless of the proof checking mode
@@ -46,6 +62,26 @@ std::shared_ptr<ProofNode> ProofNodeManager::mkNode(
 {
   Trace("pnm") << "ProofNodeManager::mkNode " << id << " {" << expected.getId()
                << "} " << expected << "\n";
+  // Assumptions are not shared, since they are placeholders that their owner
+  // may update in place, e.g. when closing them in mkScope.
+  bool hashCons = d_opts.proof.proofHashCons && id != PfRule::ASSUME;
+  size_t hash = 0;
+  if (hashCons)
+  {
+    hash = hashNode(id, children, args);
+    std::shared_ptr<ProofNode> pn =
+        lookupNode(hash, id, children, args, expected);
+    if (pn != nullptr)
+    {
+      ++d_nodesShared;
+      d_bytesSaved += sizeof(ProofNode)
+                      + children.size() * sizeof(std::shared_ptr<ProofNode>)
+                      + args.size() * sizeof(Node);
+      d_sharedRules << id;
+      pn->d_isShared = true;
+      return pn;
+    }
+  }
   bool didCheck = false;
   Node res = checkInternal(id, children, args, expected, didCheck);
   if (res.isNull())
@@ -58,9 +94,144 @@ std::shared_ptr<ProofNode> ProofNodeManager::mkNode(
       std::make_shared<ProofNode>(id, children, args);
   pn->d_proven = res;
   pn->d_provenChecked = didCheck;
+  ++d_nodesCreated;
+  if (hashCons)
+  {
+    d_store[hash].push_back(pn);
+    if (++d_storeSize > 2 * d_store.size() + 1024)
+    {
+      cleanupStore();
+    }
+  }
   return pn;
 }
 
+size_t ProofNodeManager::hashNode(
+    PfRule id,
+    const std::vector<std::shared_ptr<ProofNode>>& children,
+    const std::vector<Node>& args)
+{
+  uint64_t hash = fnv1a::fnv1a_64(static_cast<uint64_t>(id));
+  for (const std::shared_ptr<ProofNode>& c : children)
+  {
+    hash = fnv1a::fnv1a_64(reinterpret_cast<uintptr_t>(c.get()), hash);
+  }
+  for (const Node& a : args)
+  {
+    hash = fnv1a::fnv1a_64(a.getId(), hash);
+  }
+  return static_cast<size_t>(hash);
+}
+
+std::shared_ptr<ProofNode> ProofNodeManager::lookupNode(
+    size_t hash,
+    PfRule id,
+    const std::vector<std::shared_ptr<ProofNode>>& children,
+    const std::vector<Node>& args,
+    Node expected)
+{
+  auto it = d_store.find(hash);
+  if (it == d_store.end())
+  {
+    return nullptr;
+  }
+  std::vector<std::weak_ptr<ProofNode>>& bucket = it->second;
+  std::shared_ptr<ProofNode> res;
+  size_t j = 0;
+  for (size_t i = 0, size = bucket.size(); i < size; ++i)
+  {
+    std::shared_ptr<ProofNode> pn = bucket[i].lock();
+    if (pn == nullptr)
+    {
+      // expired, remove it
+      continue;
+    }
+    // Note that pn may have been updated since it was added to the store, so
+    // we compare its current contents.
+    if (res == nullptr && pn->d_rule == id && pn->d_children == children
+        && pn->d_args == args
+        && (expected.isNull() || pn->d_proven == expected))
+    {
+      res = pn;
+    }
+    bucket[j++] = bucket[i];
+  }
+  d_storeSize -= bucket.size() - j;
+  bucket.resize(j);
+  if (bucket.empty())
+  {
+    d_store.erase(it);
+  }
+  return res;
+}
+
+bool ProofNodeManager::hasFreeAssumptionsOf(
+    ProofNode* pn,
+    PfRule id,
+    const std::vector<std::shared_ptr<ProofNode>>& children,
+    const std::vector<Node>& args)
+{
+  Assert(pn->d_isShared);
+  if (pn->d_sharedAssumps == nullptr)
+  {
+    std::vector<Node> assumps;
+    expr::getFreeAssumptions(pn, assumps);
+    pn->d_sharedAssumps = std::make_unique<std::unordered_set<Node>>(
+        assumps.begin(), assumps.end());
+  }
+  const std::unordered_set<Node>& fa = *pn->d_sharedAssumps;
+  std::unordered_set<Node> scopeArgs;
+  if (id == PfRule::SCOPE)
+  {
+    // the arguments of SCOPE are not free assumptions
+    scopeArgs.insert(args.begin(), args.end());
+  }
+  auto isIncluded = [&fa, &scopeArgs](const Node& a) {
+    return fa.find(a) != fa.end() || scopeArgs.find(a) != scopeArgs.end();
+  };
+  for (const std::shared_ptr<ProofNode>& c : children)
+  {
+    // the cached assumptions of a shared child include its free assumptions,
+    // hence we only traverse it if they are not included
+    if (c->d_sharedAssumps != nullptr
+        && std::all_of(c->d_sharedAssumps->begin(),
+                       c->d_sharedAssumps->end(),
+                       isIncluded))
+    {
+      continue;
+    }
+    std::vector<Node> cassumps;
+    expr::getFreeAssumptions(c.get(), cassumps);
+    if (!std::all_of(cassumps.begin(), cassumps.end(), isIncluded))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ProofNodeManager::cleanupStore()
+{
+  d_storeSize = 0;
+  for (auto it = d_store.begin(); it != d_store.end();)
+  {
+    std::vector<std::weak_ptr<ProofNode>>& bucket = it->second;
+    bucket.erase(std::remove_if(bucket.begin(),
+                                bucket.end(),
+                                [](const std::weak_ptr<ProofNode>& pn) {
+                                  return pn.expired();
+                                }),
+                 bucket.end());
+    if (bucket.empty())
+    {
+      it = d_store.erase(it);
+      continue;
+    }
+    d_storeSize += bucket.size();
+    ++it;
+  }
+}
+
 std::shared_ptr<ProofNode> ProofNodeManager::mkAssume(Node fact)
 {
   Assert(!fact.isNull());
@@ -299,11 +470,15 @@ bool ProofNodeManager::updateNode(ProofNode* pn, ProofNode* pnr)
   {
     return false;
   }
+  // can shortcut re-check of rule
+  if (!updateNodeInternal(
+          pn, pnr->getRule(), pnr->getChildren(), pnr->getArguments(), false))
+  {
+    return false;
+  }
   // copy whether we did the check
   pn->d_provenChecked = pnr->d_provenChecked;
-  // can shortcut re-check of rule
-  return updateNodeInternal(
-      pn, pnr->getRule(), pnr->getChildren(), pnr->getArguments(), false);
+  return true;
 }
 
 void ProofNodeManager::ensureChecked(ProofNode* pn)
@@ -320,6 +495,41 @@ void ProofNodeManager::ensureChecked(ProofNode* pn)
   Assert(res == pn->d_proven);
 }
 
+size_t ProofNodeManager::ensureCheckedDag(ProofNode* pn)
+{
+  size_t nchecked = 0;
+  std::unordered_map<ProofNode*, bool> visited;
+  std::unordered_map<ProofNode*, bool>::iterator it;
+  std::vector<ProofNode*> visit;
+  ProofNode* cur;
+  visit.push_back(pn);
+  do
+  {
+    cur = visit.back();
+    it = visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = false;
+      for (const std::shared_ptr<ProofNode>& cp : cur->d_children)
+      {
+        visit.push_back(cp.get());
+      }
+      continue;
+    }
+    visit.pop_back();
+    if (!it->second)
+    {
+      it->second = true;
+      if (!cur->d_provenChecked)
+      {
+        ensureChecked(cur);
+        nchecked++;
+      }
+    }
+  } while (!visit.empty());
+  return nchecked;
+}
+
 Node ProofNodeManager::checkInternal(
     PfRule id,
     const std::vector<std::shared_ptr<ProofNode>>& children,
@@ -437,13 +647,25 @@ bool ProofNodeManager::updateNodeInternal(
 {
   Assert(pn != nullptr);
   // ---------------- check for cyclic
-  if (d_opts.proof.proofCheck == options::ProofCheckMode::EAGER)
+  // If pn is shared by hash-consing, the update may make it cyclic, even if
+  // the callers of mkNode constructed their proofs in an acyclic way. In this
+  // case, we do not update pn.
+  if (pn->d_isShared
+      || d_opts.proof.proofCheck == options::ProofCheckMode::EAGER)
   {
     std::unordered_set<const ProofNode*> visited;
     for (const std::shared_ptr<ProofNode>& cpc : children)
     {
       if (expr::containsSubproof(cpc.get(), pn, visited))
       {
+        if (pn->d_isShared)
+        {
+          Trace("pnm") << "ProofNodeManager::updateNode: do not make shared "
+                          "proof node cyclic"
+                       << std::endl;
+          ++d_sharedUpdatesRejected;
+          return false;
+        }
         std::stringstream ss;
         ss << "ProofNodeManager::updateNode: attempting to make cyclic proof! "
            << id << " " << pn->getResult() << ", children = " << std::endl;
@@ -464,6 +686,18 @@ bool ProofNodeManager::updateNodeInternal(
   }
   // ---------------- end check for cyclic
 
+  // If pn is shared by hash-consing, it may be a subproof of proofs other than
+  // the one of the caller. We only update it if this does not introduce free
+  // assumptions, so that these proofs remain closed.
+  if (pn->d_isShared && !hasFreeAssumptionsOf(pn, id, children, args))
+  {
+    Trace("pnm") << "ProofNodeManager::updateNode: do not add free assumptions "
+                    "to shared proof node"
+                 << std::endl;
+    ++d_sharedUpdatesRejected;
+    return false;
+  }
+
   // should have already computed what is proven
   Assert(!pn->d_proven.isNull())
       << "ProofNodeManager::updateProofNode: invalid proof provided";
@@ -18,10 +18,13 @@
 #ifndef CVC5__PROOF__PROOF_NODE_MANAGER_H
 #define CVC5__PROOF__PROOF_NODE_MANAGER_H
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "expr/node.h"
 #include "proof/proof_rule.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
@@ -51,10 +54,14 @@ class Rewriter;
  * unchanged and updates (if possible) the remaining content of a given proof
  * node.
  *
- * Notice that ProofNode objects are mutable, and hence this class does not
- * cache the results of mkNode. A version of this class that caches
- * immutable version of ProofNode objects could be built as an extension
- * or layer on top of this class.
+ * Notice that ProofNode objects are mutable, and hence by default this class
+ * does not cache the results of mkNode. If the option proofHashCons is
+ * enabled, mkNode returns an existing proof node with the same rule, children
+ * and arguments (and conclusion) if there is one that is still alive, so that
+ * identical subproofs are stored once. Assumptions are never shared, since
+ * they are updated in place when they are closed, e.g. by mkScope. Since
+ * shared proof nodes may belong to several proofs, updateNode rejects updates
+ * that would make a shared proof node cyclic or add free assumptions to it.
  */
 class ProofNodeManager
 {
@@ -158,7 +165,8 @@ class ProofNodeManager
    * @return true if the update was successful.
    *
    * Notice that updateNode always returns true if there is no underlying
-   * checker.
+   * checker, unless pn is shared by hash-consing, in which case the update is
+   * rejected if it would make pn cyclic or add free assumptions to it.
    */
   bool updateNode(ProofNode* pn,
                   PfRule id,
@@ -174,6 +182,14 @@ class ProofNodeManager
    * Ensure that pn is checked, regardless of the proof check format.
    */
   void ensureChecked(ProofNode* pn);
+  /**
+   * Ensure that all nodes of the proof pn are checked. Each node of the
+   * proof dag is visited once, and only the nodes that have not been checked
+   * yet (e.g. during their construction or during post-processing) are
+   * checked, children before their parents. Returns the number of nodes that
+   * were checked.
+   */
+  size_t ensureCheckedDag(ProofNode* pn);
   /** Get the underlying proof checker */
   ProofChecker* getChecker() const;
   /**
@@ -199,6 +215,52 @@ class ProofNodeManager
   ProofChecker* d_checker;
   /** the true node */
   Node d_true;
+  /**
+   * The hash-consed proof nodes, indexed by the hash of their rule, children
+   * and arguments at the time they were constructed. This is only used if
+   * the option proofHashCons is enabled.
+   */
+  std::unordered_map<size_t, std::vector<std::weak_ptr<ProofNode>>> d_store;
+  /** The number of entries in d_store after it was last cleaned up */
+  size_t d_storeSize;
+  /** The number of proof nodes constructed by mkNode */
+  IntStat d_nodesCreated;
+  /** The number of calls to mkNode that returned an existing proof node */
+  IntStat d_nodesShared;
+  /** An estimate of the memory (in bytes) saved by sharing proof nodes */
+  IntStat d_bytesSaved;
+  /** The rules of the shared proof nodes */
+  HistogramStat<PfRule> d_sharedRules;
+  /** The number of updates of shared proof nodes that updateNode rejected */
+  IntStat d_sharedUpdatesRejected;
+  /** Compute the hash of a proof node with the given contents */
+  static size_t hashNode(
+      PfRule id,
+      const std::vector<std::shared_ptr<ProofNode>>& children,
+      const std::vector<Node>& args);
+  /**
+   * Get an existing proof node with the given contents that proves expected
+   * (if non-null) from the store, or null if there is none.
+   */
+  std::shared_ptr<ProofNode> lookupNode(
+      size_t hash,
+      PfRule id,
+      const std::vector<std::shared_ptr<ProofNode>>& children,
+      const std::vector<Node>& args,
+      Node expected);
+  /**
+   * Are the free assumptions of a proof node with the given contents included
+   * in the free assumptions of the shared proof node pn? This caches the free
+   * assumptions of pn, and uses the cached free assumptions of shared children
+   * to avoid traversing them.
+   */
+  static bool hasFreeAssumptionsOf(
+      ProofNode* pn,
+      PfRule id,
+      const std::vector<std::shared_ptr<ProofNode>>& children,
+      const std::vector<Node>& args);
+  /** Remove the expired proof nodes from the store */
+  void cleanupStore();
   /** Check internal
    *
    * This returns the result of proof checking a ProofNode with the provided
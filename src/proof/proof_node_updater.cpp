@@ -109,13 +109,16 @@ void ProofNodeUpdater::processInternal(std::shared_ptr<ProofNode> pf,
         itc = resCache.find(res);
         if (itc != resCache.end())
         {
-          // already have a proof, merge it into this one
-          visited[cur] = true;
-          d_pnm->updateNode(cur.get(), itc->second.get());
-          // does not contain free assumptions since the range of resCache does
-          // not contain free assumptions
-          cfaMap[cur.get()] = false;
-          continue;
+          // already have a proof, merge it into this one, which may be
+          // rejected if cur is shared
+          if (d_pnm->updateNode(cur.get(), itc->second.get()))
+          {
+            visited[cur] = true;
+            // does not contain free assumptions since the range of resCache
+            // does not contain free assumptions
+            cfaMap[cur.get()] = false;
+            continue;
+          }
         }
       }
       // run update to a fixed point
@@ -214,7 +217,13 @@ bool ProofNodeUpdater::runUpdate(std::shared_ptr<ProofNode> cur,
     }
     // then, update the original proof node based on this one
     Trace("pf-process-debug") << "Update node..." << std::endl;
-    d_pnm->updateNode(cur.get(), npn.get());
+    if (!d_pnm->updateNode(cur.get(), npn.get()))
+    {
+      // the update was rejected, e.g. since cur is shared by hash-consing and
+      // npn has other free assumptions, hence cur is unchanged
+      Trace("pf-process-debug") << "...update node rejected." << std::endl;
+      return false;
+    }
     Trace("pf-process-debug") << "...update node finished." << std::endl;
     if (d_debugFreeAssumps)
     {
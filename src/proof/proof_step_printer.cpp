@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of printing proofs as lists of steps.
+ */
+
+#include "proof/proof_step_printer.h"
+
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "base/check.h"
+#include "proof/proof_node.h"
+
+namespace cvc5 {
+namespace proof {
+
+void ProofStepPrinter::print(std::ostream& out, const ProofNode* pn)
+{
+  // Maps each visited proof node to the identifier of its step, or to 0 if
+  // its step has not been printed yet.
+  std::unordered_map<const ProofNode*, size_t> ids;
+  std::unordered_map<const ProofNode*, size_t>::iterator it;
+  std::vector<const ProofNode*> visit;
+  const ProofNode* cur;
+  size_t nextId = 1;
+  visit.push_back(pn);
+  do
+  {
+    cur = visit.back();
+    it = ids.find(cur);
+    if (it == ids.end())
+    {
+      ids[cur] = 0;
+      for (const std::shared_ptr<ProofNode>& cp : cur->getChildren())
+      {
+        visit.push_back(cp.get());
+      }
+      continue;
+    }
+    visit.pop_back();
+    if (it->second != 0)
+    {
+      continue;
+    }
+    it->second = nextId++;
+    out << "(step s" << it->second << " " << cur->getResult() << " :rule "
+        << cur->getRule();
+    const std::vector<std::shared_ptr<ProofNode>>& children =
+        cur->getChildren();
+    if (!children.empty())
+    {
+      out << " :premises (";
+      for (size_t i = 0, size = children.size(); i < size; i++)
+      {
+        Assert(ids[children[i].get()] != 0);
+        out << (i == 0 ? "s" : " s") << ids[children[i].get()];
+      }
+      out << ")";
+    }
+    const std::vector<Node>& args = cur->getArguments();
+    if (!args.empty())
+    {
+      out << " :args (";
+      for (size_t i = 0, size = args.size(); i < size; i++)
+      {
+        out << (i == 0 ? "" : " ") << args[i];
+      }
+      out << ")";
+    }
+    out << ")\n";
+  } while (!visit.empty());
+}
+
+}  // namespace proof
+}  // namespace cvc5
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Printing proofs as lists of steps.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PROOF__PROOF_STEP_PRINTER_H
+#define CVC5__PROOF__PROOF_STEP_PRINTER_H
+
+#include <iosfwd>
+
+namespace cvc5 {
+
+class ProofNode;
+
+namespace proof {
+
+/**
+ * Prints a proof as a list of steps in topological order, where each step is
+ * printed as soon as the steps of all of its premises have been printed:
+ *
+ *   (step s<id> <conclusion> :rule <rule> :premises (s<id> ...) :args (...))
+ *
+ * The :premises and :args fields are omitted if they are empty. Each node of
+ * the proof dag is printed once, and premises refer to the identifiers of
+ * previously printed steps. In contrast to printing a proof as a single
+ * term, this does not construct any intermediate representation of the
+ * proof, the only data kept while printing is the identifier of each step,
+ * and the size of the output is linear in the size of the proof dag.
+ */
+class ProofStepPrinter
+{
+ public:
+  /**
+   * Print the proof pn on out.
+   * @param out the output stream
+   * @param pn the root node of the proof to print
+   */
+  static void print(std::ostream& out, const ProofNode* pn);
+};
+
+}  // namespace proof
+}  // namespace cvc5
+
+#endif
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Writing clausal (DRAT) proofs of the Minisat search.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef Minisat_DratWriter_h
+#define Minisat_DratWriter_h
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "base/exception.h"
+#include "prop/minisat/core/SolverTypes.h"
+
+namespace cvc5 {
+namespace Minisat {
+
+/**
+ * Writes a clausal proof of the search of the SAT solver in the DRAT format,
+ * where clauses are written as soon as they are learned or deleted, so that
+ * no part of the proof is kept in memory.
+ *
+ * The clauses that the SAT solver does not derive, i.e. the input clauses,
+ * theory lemmas and theory explanations, are written in DIMACS format to a
+ * separate clause file, whose header is written when the proof ends or the
+ * writer is destroyed. A DRAT checker, given these two files, checks that the
+ * proof derives the empty clause from the clauses of the clause file. Theory
+ * lemmas are thus trusted, and are not checked.
+ */
+class DratWriter
+{
+ public:
+  /**
+   * Open file for writing the proof, and file + ".cnf" for writing the
+   * clauses given to the SAT solver.
+   */
+  DratWriter(const std::string& file)
+      : d_proof(file),
+        d_cnf(file + ".cnf"),
+        d_numClauses(0),
+        d_maxVar(0),
+        d_emptyClause(false)
+  {
+    if (!d_proof.is_open() || !d_cnf.is_open())
+    {
+      throw Exception("could not open " + file + " and " + file
+                      + ".cnf for writing the SAT proof");
+    }
+    // reserve space for the header, which is written by writeHeader
+    d_cnf << std::string(s_headerWidth, ' ') << "\n";
+  }
+  ~DratWriter() { writeHeader(); }
+  /** Write the clause c given to the SAT solver */
+  template <class C>
+  void addOriginal(const C& c)
+  {
+    writeLits(d_cnf, c);
+    d_numClauses++;
+  }
+  /** Write the addition of the clause c derived by the SAT solver */
+  template <class C>
+  void addDerived(const C& c)
+  {
+    writeLits(d_proof, c);
+  }
+  /** Write the deletion of the clause c */
+  template <class C>
+  void deleteClause(const C& c)
+  {
+    d_proof << "d ";
+    writeLits(d_proof, c);
+  }
+  /**
+   * Write the empty clause, which ends the proof. Since the solver may exit
+   * without running destructors, this also writes the header and flushes
+   * both files.
+   */
+  void addEmptyClause()
+  {
+    if (!d_emptyClause)
+    {
+      d_emptyClause = true;
+      d_proof << "0\n";
+      writeHeader();
+    }
+  }
+
+ private:
+  /** The number of characters reserved for the header of the clause file */
+  static constexpr size_t s_headerWidth = 48;
+  /** Write the header of the clause file, and flush both files */
+  void writeHeader()
+  {
+    std::streampos end = d_cnf.tellp();
+    d_cnf.seekp(0);
+    d_cnf << "p cnf " << d_maxVar << " " << d_numClauses;
+    d_cnf.seekp(end);
+    d_cnf.flush();
+    d_proof.flush();
+  }
+  /** Write the literals of c, terminated by 0, to out */
+  template <class C>
+  void writeLits(std::ostream& out, const C& c)
+  {
+    for (int i = 0, size = c.size(); i < size; i++)
+    {
+      int v = var(c[i]) + 1;
+      d_maxVar = v > d_maxVar ? v : d_maxVar;
+      out << (sign(c[i]) ? "-" : "") << v << " ";
+    }
+    out << "0\n";
+  }
+  /** The proof file */
+  std::ofstream d_proof;
+  /** The file for the clauses given to the SAT solver */
+  std::ofstream d_cnf;
+  /** The number of clauses written to d_cnf */
+  uint64_t d_numClauses;
+  /** The largest (DIMACS) variable written so far */
+  int d_maxVar;
+  /** Whether the empty clause was written */
+  bool d_emptyClause;
+};
+
+}  // namespace Minisat
+}  // namespace cvc5
+
+#endif
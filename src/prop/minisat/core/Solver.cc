@@ -224,6 +224,17 @@ Solver::Solver(Env& env,
   // Assert the constants
   uncheckedEnqueue(mkLit(varTrue, false));
   uncheckedEnqueue(mkLit(varFalse, true));
+
+  if (!options().prop.satDratFile.empty())
+  {
+    d_drat.reset(new DratWriter(options().prop.satDratFile));
+    // the constants are given as unit clauses
+    vec<Lit> unit;
+    unit.push(mkLit(varTrue, false));
+    d_drat->addOriginal(unit);
+    unit[0] = mkLit(varFalse, true);
+    d_drat->addOriginal(unit);
+  }
 }
 
 
@@ -332,6 +343,10 @@ CRef Solver::reason(Var x) {
                               explanation_cl);
   vec<Lit> explanation;
   MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
+  if (d_drat)
+  {
+    d_drat->addOriginal(explanation);
+  }
 
   Trace("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
                    << std::endl;
@@ -397,6 +412,12 @@ CRef Solver::reason(Var x) {
       // Add not TRUE to the clause
       explanation.push(mkLit(varTrue, true));
     }
+    // the simplified explanation follows from the original one by unit
+    // propagation
+    if (d_drat && (i != j || j == 1))
+    {
+      d_drat->addDerived(explanation);
+    }
   }
 
   // Construct the reason
@@ -413,6 +434,11 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 {
     if (!ok) return false;
 
+    if (d_drat)
+    {
+      d_drat->addOriginal(ps);
+    }
+
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p; int i, j;
@@ -422,6 +448,7 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 
     // Check the clause for tautologies and similar
     int falseLiteralsCount = 0;
+    bool removedFalse = false;
     for (i = j = 0, p = lit_Undef; i < ps.size(); i++) {
       // Update the level
       clauseLevel = d_assertionLevelOnly
@@ -448,6 +475,7 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
         if (!options().smt.unsatCores && !needProof() && level(var(ps[i])) == 0
             && user_level(var(ps[i])) == 0)
         {
+          removedFalse = true;
           continue;
         }
         else
@@ -463,6 +491,11 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
     // Fit to size
     ps.shrink(i - j);
 
+    if (d_drat && removedFalse)
+    {
+      d_drat->addDerived(ps);
+    }
+
     // If we are in solve_ or propagate
     if (minisat_busy)
     {
@@ -480,6 +513,10 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 
       // If all false, we're in conflict
       if (ps.size() == falseLiteralsCount) {
+        if (d_drat)
+        {
+          d_drat->addEmptyClause();
+        }
         if (options().smt.unsatCores || needProof())
         {
           // Take care of false units here; otherwise, we need to
@@ -545,6 +582,10 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
           }
           CRef confl = propagate(CHECK_WITHOUT_THEORY);
           if(! (ok = (confl == CRef_Undef)) ) {
+            if (d_drat)
+            {
+              d_drat->addEmptyClause();
+            }
             if (needProof())
             {
               if (ca[confl].size() == 1)
@@ -652,6 +693,10 @@ void Solver::removeClause(CRef cr) {
       }
       vardata[var(c[0])].d_reason = CRef_Undef;
     }
+    if (d_drat)
+    {
+      d_drat->deleteClause(c);
+    }
     c.mark(1);
     ca.free(cr);
 }
@@ -1277,6 +1322,12 @@ void Solver::propagateTheory() {
     Lit p = propagatedLiterals[i];
     if (value(p) == l_Undef) {
       uncheckedEnqueue(p, CRef_Lazy);
+      // Propagations at level zero are not explained by conflict analysis,
+      // but the DRAT proof may depend on their explanations
+      if (d_drat && decisionLevel() == 0)
+      {
+        reason(var(p));
+      }
     } else {
       if (value(p) == l_False) {
         Debug("minisat") << "Conflict in theory propagation" << std::endl;
@@ -1530,6 +1581,10 @@ lbool Solver::search(int nof_conflicts)
 
       if (decisionLevel() == 0)
       {
+        if (d_drat)
+        {
+          d_drat->addEmptyClause();
+        }
         if (needProof())
         {
           if (confl == CRef_Lazy)
@@ -1548,6 +1603,10 @@ lbool Solver::search(int nof_conflicts)
       learnt_clause.clear();
       int max_level = analyze(confl, learnt_clause, backtrack_level);
       cancelUntil(backtrack_level);
+      if (d_drat)
+      {
+        d_drat->addDerived(learnt_clause);
+      }
 
       // Assert the conflict clause and the asserting literal
       if (learnt_clause.size() == 1)
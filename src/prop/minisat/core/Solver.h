@@ -29,6 +29,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "cvc5_private.h"
 #include "proof/clause_id.h"
 #include "proof/proof_node_manager.h"
+#include "prop/minisat/core/DratWriter.h"
 #include "prop/minisat/core/SolverTypes.h"
 #include "prop/minisat/mtl/Alg.h"
 #include "prop/minisat/mtl/Heap.h"
@@ -89,6 +90,9 @@ class Solver : protected EnvObj
   /** The resolution proof manager */
   std::unique_ptr<cvc5::prop::SatProofManager> d_pfManager;
 
+  /** The writer of the DRAT proof, if option satDratFile is set */
+  std::unique_ptr<DratWriter> d_drat;
+
  public:
   /** Returns the current user assertion level */
   int getAssertionLevel() const { return assertionLevel; }
@@ -168,6 +168,8 @@ ClauseId MinisatSatSolver::addClause(SatClause& clause, bool removable) {
   d_minisat->addClause(minisat_clause, removable, clause_id);
   // FIXME: to be deleted when we kill old proof code for unsat cores
   Assert(!options().smt.unsatCores || options().smt.produceProofs
+         || options().smt.unsatCoresMode
+                == options::UnsatCoresMode::DEPENDENCIES
          || clause_id != ClauseIdError);
   return clause_id;
 }
@@ -67,9 +67,10 @@ SimpSolver::SimpSolver(Env& env,
       asymm_lits(0),
       eliminated_vars(0),
       elimorder(1),
+      // TODO: turn off simplifications if proofs are on initially. They
+      // are also not recorded in DRAT proofs.
       use_simplification(!enableIncremental && !options().smt.unsatCores
-                         && !pnm)  // TODO: turn off simplifications if
-                                   // proofs are on initially
+                         && !pnm && options().prop.satDratFile.empty())
       ,
       occurs(ClauseDeleted(ca)),
       elim_heap(ElimLt(n_occ)),
@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Tracking of the input assertions that preprocessed assertions depend on.
+ */
+
+#include "smt/preprocess_dependencies.h"
+
+#include <unordered_set>
+
+#include "preprocessing/assertion_pipeline.h"
+#include "smt/env.h"
+#include "theory/trust_substitutions.h"
+
+using namespace cvc5::preprocessing;
+
+namespace cvc5 {
+namespace smt {
+
+PreprocessDependencies::PreprocessDependencies(Env& env)
+    : EnvObj(env),
+      d_numSubsts(0),
+      d_learnedSubsts(false),
+      d_none(std::make_shared<const std::vector<Node>>())
+{
+}
+
+void PreprocessDependencies::notifyStart(const AssertionPipeline& ap)
+{
+  d_nodes = ap.ref();
+  d_deps.clear();
+  for (const Node& a : d_nodes)
+  {
+    d_deps.push_back(std::make_shared<const std::vector<Node>>(1, a));
+  }
+}
+
+void PreprocessDependencies::notifyPreApply(const AssertionPipeline& ap)
+{
+  synchronize(ap);
+  d_numSubsts = getNumSubstitutions();
+}
+
+void PreprocessDependencies::notifyPostApply(const std::string& pass,
+                                             const AssertionPipeline& ap)
+{
+  // applying substitutions is local if they are all function definitions
+  bool isLocal = isLocalPass(pass)
+                 || (pass == "apply-substs" && !d_learnedSubsts);
+  if (getNumSubstitutions() > d_numSubsts)
+  {
+    d_learnedSubsts = true;
+  }
+  std::vector<Deps> deps;
+  if (isLocal)
+  {
+    Assert(ap.size() >= d_nodes.size());
+    deps = d_deps;
+    // the new assertions are skolem definitions
+    deps.resize(ap.size(), d_none);
+  }
+  else
+  {
+    std::unordered_map<Node, Deps> prev;
+    for (size_t i = 0, size = d_nodes.size(); i < size; i++)
+    {
+      Deps& d = prev[d_nodes[i]];
+      if (d == nullptr)
+      {
+        d = d_deps[i];
+      }
+    }
+    for (const Node& a : ap.ref())
+    {
+      std::unordered_map<Node, Deps>::iterator it = prev.find(a);
+      deps.push_back(it != prev.end() ? it->second : nullptr);
+    }
+  }
+  Trace("pp-deps") << "PreprocessDependencies: " << pass
+                   << (isLocal ? " (local)" : "") << std::endl;
+  d_nodes = ap.ref();
+  d_deps = std::move(deps);
+}
+
+void PreprocessDependencies::notifyEnd(const AssertionPipeline& ap)
+{
+  synchronize(ap);
+  for (size_t i = 0, size = d_nodes.size(); i < size; i++)
+  {
+    if (Trace.isOn("pp-deps"))
+    {
+      Trace("pp-deps") << "PreprocessDependencies: " << d_nodes[i]
+                       << " depends on ";
+      if (d_deps[i] == nullptr)
+      {
+        Trace("pp-deps") << "all inputs" << std::endl;
+      }
+      else
+      {
+        Trace("pp-deps") << *d_deps[i] << std::endl;
+      }
+    }
+    d_ppDeps[d_nodes[i]] = d_deps[i];
+  }
+  d_nodes.clear();
+  d_deps.clear();
+}
+
+void PreprocessDependencies::getInputCore(const std::vector<Node>& ppcore,
+                                          const context::CDList<Node>& al,
+                                          const context::CDList<Node>& defs,
+                                          std::vector<Node>& core) const
+{
+  bool all = false;
+  std::unordered_set<Node> inputs;
+  for (const Node& a : ppcore)
+  {
+    std::unordered_map<Node, Deps>::const_iterator it = d_ppDeps.find(a);
+    if (it == d_ppDeps.end() || it->second == nullptr)
+    {
+      all = true;
+      break;
+    }
+    inputs.insert(it->second->begin(), it->second->end());
+  }
+  if (!all)
+  {
+    // The dependencies of an assertion were computed when it was last
+    // preprocessed, which may have been in a context that was popped since.
+    std::unordered_set<Node> current(al.begin(), al.end());
+    current.insert(defs.begin(), defs.end());
+    for (const Node& a : inputs)
+    {
+      if (current.find(a) == current.end())
+      {
+        all = true;
+        break;
+      }
+    }
+  }
+  for (const Node& a : al)
+  {
+    if (all || inputs.find(a) != inputs.end())
+    {
+      core.push_back(a);
+    }
+  }
+}
+
+void PreprocessDependencies::synchronize(const AssertionPipeline& ap)
+{
+  Assert(ap.size() >= d_nodes.size());
+  for (size_t i = 0, size = ap.size(); i < size; i++)
+  {
+    const Node& a = ap[i];
+    if (i < d_nodes.size() && a == d_nodes[i])
+    {
+      continue;
+    }
+    Deps d = a.isConst() && a.getConst<bool>() ? d_none : nullptr;
+    if (i < d_nodes.size())
+    {
+      d_nodes[i] = a;
+      d_deps[i] = d;
+    }
+    else
+    {
+      d_nodes.push_back(a);
+      d_deps.push_back(d);
+    }
+  }
+}
+
+bool PreprocessDependencies::isLocalPass(const std::string& pass) const
+{
+  // These passes replace each assertion by an equivalent one, or by an
+  // equisatisfiable one together with definitions of fresh skolems.
+  return pass == "rewrite" || pass == "ext-rew-pre"
+         || pass == "theory-rewrite-eq" || pass == "theory-preprocess"
+         || pass == "ite-removal" || pass == "bv-eager-atoms"
+         || pass == "foreign-theory-rewrite" || pass == "strings-eager-pp"
+         || pass == "quantifiers-preprocess";
+}
+
+size_t PreprocessDependencies::getNumSubstitutions() const
+{
+  return d_env.getTopLevelSubstitutions().get().size();
+}
+
+}  // namespace smt
+}  // namespace cvc5
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Tracking of the input assertions that preprocessed assertions depend on.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__SMT__PREPROCESS_DEPENDENCIES_H
+#define CVC5__SMT__PREPROCESS_DEPENDENCIES_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "context/cdlist.h"
+#include "expr/node.h"
+#include "smt/env_obj.h"
+
+namespace cvc5 {
+
+namespace preprocessing {
+class AssertionPipeline;
+}
+
+namespace smt {
+
+/**
+ * Tracks, for each assertion of the assertion pipeline, a set of input
+ * assertions it depends on. This is used for computing unsat cores without
+ * proofs (unsat cores mode DEPENDENCIES): the SAT solver computes the unsat
+ * core of the preprocessed assertions, which are asserted as assumptions,
+ * and the unsat core of the input is the union of their dependencies.
+ *
+ * The dependencies are sound, i.e. for each set of preprocessed assertions
+ * that is unsatisfiable, the union of their dependencies is unsatisfiable,
+ * but not necessarily precise. The dependencies are updated after each
+ * preprocessing pass as follows:
+ * (1) an assertion that was not changed keeps its dependencies,
+ * (2) for passes that only replace each assertion by an equisatisfiable one,
+ * which we call local passes, the replacement of an assertion inherits its
+ * dependencies, and the assertions added by the pass are definitions of fresh
+ * skolems, which have no dependencies,
+ * (3) otherwise, an assertion that was modified or added by the pass depends
+ * on all input assertions.
+ * Notice that substitutions are only local if they are definitions of
+ * functions, i.e. no substitution was learned from assertions.
+ */
+class PreprocessDependencies : protected EnvObj
+{
+ public:
+  PreprocessDependencies(Env& env);
+  /**
+   * Notify that the assertions of ap are about to be preprocessed. These are
+   * the input assertions, which depend on themselves.
+   */
+  void notifyStart(const preprocessing::AssertionPipeline& ap);
+  /** Notify that a preprocessing pass is about to be applied to ap */
+  void notifyPreApply(const preprocessing::AssertionPipeline& ap);
+  /** Notify that the preprocessing pass with the given name was applied */
+  void notifyPostApply(const std::string& pass,
+                       const preprocessing::AssertionPipeline& ap);
+  /**
+   * Notify that preprocessing has finished, after which the assertions of ap
+   * are asserted to the SAT solver.
+   */
+  void notifyEnd(const preprocessing::AssertionPipeline& ap);
+  /**
+   * Get the input assertions that the preprocessed assertions ppcore depend
+   * on, in the order of the assertion list al. Inputs that are not in al or
+   * defs (the assertions that are function definitions) are not in the
+   * current context, in which case all assertions of al are returned.
+   */
+  void getInputCore(const std::vector<Node>& ppcore,
+                    const context::CDList<Node>& al,
+                    const context::CDList<Node>& defs,
+                    std::vector<Node>& core) const;
+
+ private:
+  /**
+   * The dependencies of an assertion, where null means all input assertions.
+   */
+  using Deps = std::shared_ptr<const std::vector<Node>>;
+  /**
+   * Update d_nodes and d_deps for the changes to ap that were not made by a
+   * preprocessing pass, e.g. the placeholder assertion true. Changed or new
+   * assertions other than true depend on all input assertions.
+   */
+  void synchronize(const preprocessing::AssertionPipeline& ap);
+  /** Is the preprocessing pass with the given name local? */
+  bool isLocalPass(const std::string& pass) const;
+  /** Get the size of the top-level substitutions */
+  size_t getNumSubstitutions() const;
+  /** The assertions of the pipeline before the current pass */
+  std::vector<Node> d_nodes;
+  /** The dependencies of the assertions in d_nodes */
+  std::vector<Deps> d_deps;
+  /** The number of top-level substitutions before the current pass */
+  size_t d_numSubsts;
+  /** Whether a substitution was learned from assertions */
+  bool d_learnedSubsts;
+  /** The empty dependencies */
+  Deps d_none;
+  /** Map from preprocessed assertions to their dependencies */
+  std::unordered_map<Node, Deps> d_ppDeps;
+};
+
+}  // namespace smt
+}  // namespace cvc5
+
+#endif
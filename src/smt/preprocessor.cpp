@@ -108,6 +108,13 @@ std::vector<Node> Preprocessor::getLearnedLiterals() const
   return d_ppContext->getLearnedLiterals();
 }
 
+void Preprocessor::getInputCore(const std::vector<Node>& ppcore,
+                                Assertions& as,
+                                std::vector<Node>& core) const
+{
+  d_processor.getInputCore(ppcore, as, core);
+}
+
 void Preprocessor::cleanup() { d_processor.cleanup(); }
 
 Node Preprocessor::expandDefinitions(const Node& n)
@@ -72,6 +72,13 @@ class Preprocessor : protected EnvObj
   void clearLearnedLiterals();
   /** Get learned literals */
   std::vector<Node> getLearnedLiterals() const;
+  /**
+   * Get the input assertions of as that the preprocessed assertions ppcore
+   * depend on. This may only be called in unsat cores mode DEPENDENCIES.
+   */
+  void getInputCore(const std::vector<Node>& ppcore,
+                    Assertions& as,
+                    std::vector<Node>& core) const;
   /**
    * Cleanup, which deletes the processing passes owned by this module. This
    * is required to be done explicitly so that passes are deleted before the
@@ -59,6 +59,10 @@ ProcessAssertions::ProcessAssertions(Env& env, SolverEngineStatistics& stats)
     : EnvObj(env), d_slvStats(stats), d_preprocessingPassContext(nullptr)
 {
   d_true = NodeManager::currentNM()->mkConst(true);
+  if (options().smt.unsatCoresMode == options::UnsatCoresMode::DEPENDENCIES)
+  {
+    d_deps.reset(new PreprocessDependencies(env));
+  }
 }
 
 ProcessAssertions::~ProcessAssertions()
@@ -110,6 +114,10 @@ bool ProcessAssertions::apply(Assertions& as)
     // nothing to do
     return true;
   }
+  if (d_deps != nullptr)
+  {
+    d_deps->notifyStart(assertions);
+  }
 
   if (options().bv.bvGaussElim)
   {
@@ -336,6 +344,10 @@ bool ProcessAssertions::apply(Assertions& as)
     applyPass("bv-eager-atoms", as);
   }
 
+  if (d_deps != nullptr)
+  {
+    d_deps->notifyEnd(assertions);
+  }
   Trace("smt-proc") << "ProcessAssertions::apply() end" << endl;
   dumpAssertions("assertions::post-everything", as);
   Trace("assertions::post-everything") << std::endl;
@@ -502,10 +514,29 @@ PreprocessingPassResult ProcessAssertions::applyPass(const std::string& pname,
 {
   dumpAssertions("assertions::pre-" + pname, as);
   AssertionPipeline& assertions = as.getAssertionPipeline();
+  if (d_deps != nullptr)
+  {
+    d_deps->notifyPreApply(assertions);
+  }
   PreprocessingPassResult res = d_passes[pname]->apply(&assertions);
+  if (d_deps != nullptr)
+  {
+    d_deps->notifyPostApply(pname, assertions);
+  }
   dumpAssertions("assertions::post-" + pname, as);
   return res;
 }
 
+void ProcessAssertions::getInputCore(const std::vector<Node>& ppcore,
+                                     Assertions& as,
+                                     std::vector<Node>& core) const
+{
+  Assert(d_deps != nullptr);
+  d_deps->getInputCore(ppcore,
+                       as.getAssertionList(),
+                       as.getAssertionListDefinitions(),
+                       core);
+}
+
 }  // namespace smt
 }  // namespace cvc5
@@ -24,6 +24,7 @@
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
 #include "smt/env_obj.h"
+#include "smt/preprocess_dependencies.h"
 #include "util/resource_manager.h"
 
 namespace cvc5 {
@@ -77,6 +78,14 @@ class ProcessAssertions : protected EnvObj
    * @param as The assertions.
    */
   bool apply(Assertions& as);
+  /**
+   * Get the input assertions of as that the preprocessed assertions ppcore
+   * depend on, see PreprocessDependencies. This may only be called in unsat
+   * cores mode DEPENDENCIES.
+   */
+  void getInputCore(const std::vector<Node>& ppcore,
+                    Assertions& as,
+                    std::vector<Node>& core) const;
 
  private:
   /** Reference to the SMT stats */
@@ -96,6 +105,11 @@ class ProcessAssertions : protected EnvObj
    * Number of calls of simplify assertions active.
    */
   unsigned d_simplifyAssertionsDepth;
+  /**
+   * The dependencies of the assertions on the input, if we are in unsat cores
+   * mode DEPENDENCIES.
+   */
+  std::unique_ptr<PreprocessDependencies> d_deps;
   /** Spend resource r by the resource manager of this class. */
   void spendResource(Resource r);
   /**
@@ -27,6 +27,7 @@
 #include "proof/proof_checker.h"
 #include "proof/proof_node_algorithm.h"
 #include "proof/proof_node_manager.h"
+#include "proof/proof_step_printer.h"
 #include "smt/assertions.h"
 #include "smt/difficulty_post_processor.h"
 #include "smt/env.h"
@@ -40,7 +41,9 @@ PfManager::PfManager(Env& env)
     : EnvObj(env),
       d_pchecker(new ProofChecker(
           options().proof.proofCheck == options::ProofCheckMode::EAGER,
-          options().proof.proofPedantic)),
+          options().proof.proofPedantic,
+          nullptr,
+          options().base.statistics)),
       d_pnm(new ProofNodeManager(
           env.getOptions(), env.getRewriter(), d_pchecker.get())),
       d_pppg(nullptr),
@@ -157,6 +160,15 @@ void PfManager::setFinalProof(std::shared_ptr<ProofNode> pfn, Assertions& as)
   // minimize the used assertions.
   d_finalProof =
       d_pnm->mkScope(pfn, assertions, true, options().proof.proofPruneInput);
+  if (options().proof.proofCheck != options::ProofCheckMode::NONE)
+  {
+    // Check the steps that were not checked during construction, each step of
+    // the final proof dag once. Since checked proof nodes are marked, this
+    // only checks the steps added since the last check in incremental mode.
+    size_t nchecked = d_pnm->ensureCheckedDag(d_finalProof.get());
+    Trace("smt-proof") << "SolverEngine::setFinalProof(): checked " << nchecked
+                       << " additional steps" << std::endl;
+  }
   Trace("smt-proof") << "SolverEngine::setFinalProof(): finished.\n";
 }
 
@@ -169,7 +181,8 @@ void PfManager::printProof(std::ostream& out,
   // if we are in incremental mode, we don't want to invalidate the proof
   // nodes in fp, since these may be reused in further check-sat calls
   if (options().base.incrementalSolving
-      && options().proof.proofFormatMode != options::ProofFormatMode::NONE)
+      && options().proof.proofFormatMode != options::ProofFormatMode::NONE
+      && options().proof.proofFormatMode != options::ProofFormatMode::STEPS)
   {
     fp = d_pnm->clone(fp);
   }
@@ -205,6 +218,13 @@ void PfManager::printProof(std::ostream& out,
     out << "% SZS output end Proof for " << options().driver.filename
         << std::endl;
   }
+  else if (options().proof.proofFormatMode == options::ProofFormatMode::STEPS)
+  {
+    // print the steps of the proof dag, without converting it to a term
+    out << "(proof\n";
+    proof::ProofStepPrinter::print(out, fp.get());
+    out << ")\n";
+  }
   else
   {
     // otherwise, print using default printer
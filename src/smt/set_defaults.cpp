@@ -68,6 +68,12 @@ void SetDefaults::setDefaultsPre(Options& opts)
     throw OptionException(
         std::string("Unsat core mode pp-only is for internal use only."));
   }
+  if (!opts.prop.satDratFile.empty() && opts.base.incrementalSolving)
+  {
+    throw OptionException(std::string(
+        "DRAT proofs of the SAT solver are not supported in incremental "
+        "mode."));
+  }
   // implied options
   if (opts.smt.debugCheckModels)
   {
@@ -128,8 +134,10 @@ void SetDefaults::setDefaultsPre(Options& opts)
     opts.smt.unsatCoresMode = options::UnsatCoresMode::FULL_PROOF;
   }
 
-  // set proofs on if not yet set
-  if (opts.smt.unsatCores && !opts.smt.produceProofs)
+  // set proofs on if not yet set, unless cores are computed from the
+  // dependencies of preprocessed assertions, which does not require proofs
+  if (opts.smt.unsatCores && !opts.smt.produceProofs
+      && opts.smt.unsatCoresMode != options::UnsatCoresMode::DEPENDENCIES)
   {
     if (opts.smt.produceProofsWasSetByUser)
     {
@@ -163,6 +171,8 @@ void SetDefaults::setDefaultsPre(Options& opts)
     // used by the user to rephrase the input.
     opts.quantifiers.sygusInference = false;
     opts.quantifiers.sygusRewSynthInput = false;
+    // only the main solver writes its SAT proof
+    opts.prop.satDratFile.clear();
   }
 }
 
@@ -1149,8 +1159,10 @@ bool SetDefaults::incompatibleWithUnsatCores(Options& opts,
 bool SetDefaults::safeUnsatCores(const Options& opts) const
 {
   // whether we want to force safe unsat cores, i.e., if we are in the default
-  // ASSUMPTIONS mode, since other ones are experimental
-  return opts.smt.unsatCoresMode == options::UnsatCoresMode::ASSUMPTIONS;
+  // ASSUMPTIONS mode or in DEPENDENCIES mode, which relies on the same
+  // restrictions, since other ones are experimental
+  return opts.smt.unsatCoresMode == options::UnsatCoresMode::ASSUMPTIONS
+         || opts.smt.unsatCoresMode == options::UnsatCoresMode::DEPENDENCIES;
 }
 
 bool SetDefaults::incompatibleWithQuantifiers(Options& opts,
@@ -1272,6 +1284,12 @@ void SetDefaults::setDefaultsQuantifiers(const LogicInfo& logic,
       Trace("smt") << "turning on fmf-bound, for arrays-exp" << std::endl;
     }
   }
+  if (opts.quantifiers.eMatchingInc && !opts.quantifiers.triggerCodeTree)
+  {
+    Trace("smt") << "enabling trigger-code-tree for e-matching-inc"
+                 << std::endl;
+    opts.quantifiers.triggerCodeTree = true;
+  }
   if (logic.hasCardinalityConstraints())
   {
     // must have finite model finding on
@@ -1519,6 +1537,21 @@ void SetDefaults::setDefaultsSygus(Options& opts) const
     Trace("smt") << "turning on sygus" << std::endl;
   }
   opts.quantifiers.sygus = true;
+  if (opts.quantifiers.sygusEnumShardIndex >= opts.quantifiers.sygusEnumShards)
+  {
+    throw OptionException(
+        "sygus-enum-shard-index must be less than sygus-enum-shards.");
+  }
+  if ((opts.quantifiers.sygusEnumShardsWasSetByUser
+       || opts.quantifiers.sygusEnumShardIndexWasSetByUser)
+      && opts.quantifiers.sygusEnumMode != options::SygusEnumMode::FAST)
+  {
+    // only the fast enumerator is split into shards, and the auto mode may
+    // use other enumerators
+    warning() << "sygus-enum-shards and sygus-enum-shard-index only apply to "
+                 "--sygus-enum=fast."
+              << std::endl;
+  }
   // must use Ferrante/Rackoff for real arithmetic
   if (!opts.quantifiers.cegqiMidpointWasSetByUser)
   {
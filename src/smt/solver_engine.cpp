@@ -56,6 +56,7 @@
 #include "smt/solver_engine_stats.h"
 #include "smt/sygus_solver.h"
 #include "smt/unsat_core_manager.h"
+#include "smt/unsat_core_minimizer.h"
 #include "theory/quantifiers/instantiation_list.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
 #include "theory/quantifiers_engine.h"
@@ -1279,23 +1280,34 @@ UnsatCore SolverEngine::getUnsatCoreInternal()
         "Cannot get an unsat core unless immediately preceded by "
         "UNSAT/ENTAILED response.");
   }
-  // generate with new proofs
   PropEngine* pe = getPropEngine();
   Assert(pe != nullptr);
 
-  std::shared_ptr<ProofNode> pepf;
-  if (options().smt.unsatCoresMode == options::UnsatCoresMode::ASSUMPTIONS)
+  std::vector<Node> core;
+  if (options().smt.unsatCoresMode == options::UnsatCoresMode::DEPENDENCIES)
   {
-    pepf = pe->getRefutation();
+    // map the core of the preprocessed assertions to the input
+    std::vector<Node> ppcore;
+    pe->getUnsatCore(ppcore);
+    d_smtSolver->getPreprocessor()->getInputCore(ppcore, *d_asserts, core);
   }
   else
   {
-    pepf = pe->getProof();
+    // generate with new proofs
+    std::shared_ptr<ProofNode> pepf;
+    if (options().smt.unsatCoresMode == options::UnsatCoresMode::ASSUMPTIONS)
+    {
+      pepf = pe->getRefutation();
+    }
+    else
+    {
+      pepf = pe->getProof();
+    }
+    Assert(pepf != nullptr);
+    std::shared_ptr<ProofNode> pfn =
+        d_pfManager->getFinalProof(pepf, *d_asserts);
+    d_ucManager->getUnsatCore(pfn, *d_asserts, core);
   }
-  Assert(pepf != nullptr);
-  std::shared_ptr<ProofNode> pfn = d_pfManager->getFinalProof(pepf, *d_asserts);
-  std::vector<Node> core;
-  d_ucManager->getUnsatCore(pfn, *d_asserts, core);
   if (options().smt.minimalUnsatCores)
   {
     core = reduceUnsatCore(core);
@@ -1310,65 +1322,13 @@ std::vector<Node> SolverEngine::reduceUnsatCore(const std::vector<Node>& core)
 
   d_env->verbose(1) << "SolverEngine::reduceUnsatCore(): reducing unsat core"
                     << std::endl;
-  std::unordered_set<Node> removed;
-  for (const Node& skip : core)
-  {
-    std::unique_ptr<SolverEngine> coreChecker;
-    initializeSubsolver(coreChecker, *d_env.get());
-    coreChecker->setLogic(getLogicInfo());
-    coreChecker->getOptions().smt.checkUnsatCores = false;
-    // disable all proof options
-    coreChecker->getOptions().smt.produceProofs = false;
-    coreChecker->getOptions().smt.checkProofs = false;
-
-    for (const Node& ucAssertion : core)
-    {
-      if (ucAssertion != skip && removed.find(ucAssertion) == removed.end())
-      {
-        Node assertionAfterExpansion = expandDefinitions(ucAssertion);
-        coreChecker->assertFormula(assertionAfterExpansion);
-      }
-    }
-    Result r;
-    try
-    {
-      r = coreChecker->checkSat();
-    }
-    catch (...)
-    {
-      throw;
-    }
-
-    if (r.asSatisfiabilityResult().isSat() == Result::UNSAT)
-    {
-      removed.insert(skip);
-    }
-    else if (r.asSatisfiabilityResult().isUnknown())
-    {
-      d_env->warning()
-          << "SolverEngine::reduceUnsatCore(): could not reduce unsat core "
-             "due to "
-             "unknown result.";
-    }
-  }
-
-  if (removed.empty())
+  std::vector<Node> ecore;
+  for (const Node& ucAssertion : core)
   {
-    return core;
-  }
-  else
-  {
-    std::vector<Node> newUcAssertions;
-    for (const Node& n : core)
-    {
-      if (removed.find(n) == removed.end())
-      {
-        newUcAssertions.push_back(n);
-      }
-    }
-
-    return newUcAssertions;
+    ecore.push_back(expandDefinitions(ucAssertion));
   }
+  UnsatCoreMinimizer ucm(*d_env.get());
+  return ucm.reduce(core, ecore);
 }
 
 void SolverEngine::checkUnsatCore()
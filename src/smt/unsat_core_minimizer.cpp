@@ -0,0 +1,303 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Reduction of unsat cores to minimal unsat cores.
+ */
+
+#include "smt/unsat_core_minimizer.h"
+
+#include <unordered_map>
+
+#include "options/smt_options.h"
+#include "proof/unsat_core.h"
+#include "smt/solver_engine.h"
+#include "theory/smt_engine_subsolver.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace smt {
+
+UnsatCoreMinimizer::UnsatCoreMinimizer(Env& env)
+    : EnvObj(env),
+      d_refine(options().smt.minimalUnsatCoresRefine),
+      d_warnedUnknown(false),
+      d_numChecks(statisticsRegistry().registerInt(
+          "smt::UnsatCoreMinimizer::numChecks")),
+      d_numCacheHits(statisticsRegistry().registerInt(
+          "smt::UnsatCoreMinimizer::numCacheHits")),
+      d_numRefined(statisticsRegistry().registerInt(
+          "smt::UnsatCoreMinimizer::numRefined"))
+{
+}
+
+std::vector<Node> UnsatCoreMinimizer::reduce(const std::vector<Node>& core,
+                                             const std::vector<Node>& ecore)
+{
+  Assert(core.size() == ecore.size());
+  d_assertions = ecore;
+  d_unsatCache.clear();
+  d_satCache.clear();
+  std::vector<bool> s(core.size(), true);
+  if (d_refine && !core.empty())
+  {
+    // the core may not be minimal, start with the core of the subsolver
+    std::vector<bool> subcore;
+    if (check(s, subcore) == Result::UNSAT)
+    {
+      s = subcore;
+    }
+  }
+  if (options().smt.minimalUnsatCoresMode
+      == options::MinimalUnsatCoresMode::QUICKXPLAIN)
+  {
+    std::vector<size_t> t;
+    for (size_t i = 0, size = s.size(); i < size; i++)
+    {
+      if (s[i])
+      {
+        t.push_back(i);
+      }
+    }
+    if (!t.empty())
+    {
+      std::vector<bool> b(s.size(), false);
+      std::vector<size_t> c = quickXplain(b, false, t);
+      s = b;
+      for (size_t i : c)
+      {
+        s[i] = true;
+      }
+    }
+  }
+  else
+  {
+    reduceDeletion(s);
+  }
+  std::vector<Node> mcore;
+  for (size_t i = 0, size = core.size(); i < size; i++)
+  {
+    if (s[i])
+    {
+      mcore.push_back(core[i]);
+    }
+  }
+  return mcore;
+}
+
+Result::Sat UnsatCoreMinimizer::check(const std::vector<bool>& s,
+                                      std::vector<bool>& subcore)
+{
+  Result::Sat res = lookup(s, subcore);
+  if (res != Result::SAT_UNKNOWN)
+  {
+    ++d_numCacheHits;
+    return res;
+  }
+  ++d_numChecks;
+  std::unique_ptr<SolverEngine> coreChecker;
+  theory::initializeSubsolver(coreChecker, d_env);
+  Options& opts = coreChecker->getOptions();
+  opts.smt.checkUnsatCores = false;
+  opts.smt.minimalUnsatCores = false;
+  // disable all proof options
+  opts.smt.produceProofs = false;
+  opts.smt.checkProofs = false;
+  // the subsolver only computes unsat cores if we refine by them
+  opts.smt.unsatCores = d_refine;
+  opts.smt.unsatAssumptions = false;
+  if (!d_refine)
+  {
+    opts.smt.unsatCoresMode = options::UnsatCoresMode::OFF;
+  }
+  else
+  {
+    // Compute cores from the dependencies of the preprocessed assertions,
+    // since the other modes would turn on proofs in every check. We disable
+    // simplification, whose passes would make these cores coarse.
+    opts.smt.unsatCoresMode = options::UnsatCoresMode::DEPENDENCIES;
+    opts.smt.simplificationMode = options::SimplificationMode::NONE;
+  }
+  std::unordered_map<Node, size_t> index;
+  for (size_t i = 0, size = s.size(); i < size; i++)
+  {
+    if (s[i])
+    {
+      coreChecker->assertFormula(d_assertions[i]);
+      index.emplace(d_assertions[i], i);
+    }
+  }
+  res = coreChecker->checkSat().asSatisfiabilityResult().isSat();
+  if (res == Result::UNSAT)
+  {
+    subcore = s;
+    // the subsolver may have disabled unsat cores for its options
+    if (d_refine && opts.smt.unsatCores)
+    {
+      std::vector<bool> ucore(s.size(), false);
+      bool mapped = true;
+      for (const Node& a : coreChecker->getUnsatCore())
+      {
+        std::unordered_map<Node, size_t>::iterator it = index.find(a);
+        if (it == index.end())
+        {
+          mapped = false;
+          break;
+        }
+        ucore[it->second] = true;
+      }
+      if (mapped)
+      {
+        subcore = ucore;
+      }
+    }
+    std::vector<size_t> u;
+    for (size_t i = 0, size = subcore.size(); i < size; i++)
+    {
+      if (subcore[i])
+      {
+        u.push_back(i);
+      }
+    }
+    d_numRefined += index.size() - u.size();
+    d_unsatCache.push_back(u);
+  }
+  else if (res == Result::SAT)
+  {
+    if (d_satCache.size() == s_maxSatCacheSize)
+    {
+      d_satCache.erase(d_satCache.begin());
+    }
+    d_satCache.push_back(s);
+  }
+  else
+  {
+    warnUnknown();
+  }
+  return res;
+}
+
+Result::Sat UnsatCoreMinimizer::lookup(const std::vector<bool>& s,
+                                       std::vector<bool>& subcore) const
+{
+  for (const std::vector<size_t>& u : d_unsatCache)
+  {
+    bool included = true;
+    for (size_t i : u)
+    {
+      if (!s[i])
+      {
+        included = false;
+        break;
+      }
+    }
+    if (included)
+    {
+      subcore.assign(s.size(), false);
+      for (size_t i : u)
+      {
+        subcore[i] = true;
+      }
+      return Result::UNSAT;
+    }
+  }
+  for (const std::vector<bool>& t : d_satCache)
+  {
+    bool included = true;
+    for (size_t i = 0, size = s.size(); i < size; i++)
+    {
+      if (s[i] && !t[i])
+      {
+        included = false;
+        break;
+      }
+    }
+    if (included)
+    {
+      return Result::SAT;
+    }
+  }
+  return Result::SAT_UNKNOWN;
+}
+
+void UnsatCoreMinimizer::reduceDeletion(std::vector<bool>& s)
+{
+  for (size_t i = 0, size = s.size(); i < size; i++)
+  {
+    if (!s[i])
+    {
+      continue;
+    }
+    s[i] = false;
+    std::vector<bool> subcore;
+    if (check(s, subcore) == Result::UNSAT)
+    {
+      // the assertions that were kept are in every core of s, hence in
+      // subcore as well
+      s = subcore;
+    }
+    else
+    {
+      s[i] = true;
+    }
+  }
+}
+
+std::vector<size_t> UnsatCoreMinimizer::quickXplain(
+    std::vector<bool>& b, bool hasDelta, const std::vector<size_t>& t)
+{
+  std::vector<bool> subcore;
+  if (hasDelta && check(b, subcore) == Result::UNSAT)
+  {
+    return {};
+  }
+  if (t.size() == 1)
+  {
+    return t;
+  }
+  size_t half = t.size() / 2;
+  std::vector<size_t> t1(t.begin(), t.begin() + half);
+  std::vector<size_t> t2(t.begin() + half, t.end());
+  for (size_t i : t1)
+  {
+    b[i] = true;
+  }
+  std::vector<size_t> d2 = quickXplain(b, !t1.empty(), t2);
+  for (size_t i : t1)
+  {
+    b[i] = false;
+  }
+  for (size_t i : d2)
+  {
+    b[i] = true;
+  }
+  std::vector<size_t> d1 = quickXplain(b, !d2.empty(), t1);
+  for (size_t i : d2)
+  {
+    b[i] = false;
+  }
+  d1.insert(d1.end(), d2.begin(), d2.end());
+  return d1;
+}
+
+void UnsatCoreMinimizer::warnUnknown()
+{
+  if (!d_warnedUnknown)
+  {
+    d_warnedUnknown = true;
+    warning() << "UnsatCoreMinimizer: the unsat core may not be minimal due "
+                 "to an unknown result."
+              << std::endl;
+  }
+}
+
+}  // namespace smt
+}  // namespace cvc5
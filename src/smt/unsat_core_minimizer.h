@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Reduction of unsat cores to minimal unsat cores.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__SMT__UNSAT_CORE_MINIMIZER_H
+#define CVC5__SMT__UNSAT_CORE_MINIMIZER_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "smt/env_obj.h"
+#include "util/result.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace smt {
+
+/**
+ * Reduces an unsat core to a minimal one, by checking the satisfiability of
+ * subsets of the core with subsolvers. Subsets are represented by masks over
+ * the assertions of the core.
+ *
+ * Depending on the option minimalUnsatCoresMode, this either removes the
+ * assertions one at a time (deletion), or splits the core recursively
+ * (QuickXplain), which needs a number of checks that is logarithmic in the
+ * size of the core for each assertion of the minimal core.
+ *
+ * If the option minimalUnsatCoresRefine is set, the subsolvers compute unsat
+ * cores, and the assertions that are not in the unsat core of an
+ * unsatisfiable subset are removed at once.
+ *
+ * The results of the checks are cached: since satisfiability is monotone, a
+ * subset is unsatisfiable if it includes a subset that was unsatisfiable, and
+ * satisfiable if it is included in a subset that was satisfiable.
+ */
+class UnsatCoreMinimizer : protected EnvObj
+{
+ public:
+  UnsatCoreMinimizer(Env& env);
+  /**
+   * Reduce the unsat core core, where ecore are the assertions of core with
+   * definitions expanded. Returns the minimal unsat core, whose assertions
+   * are in the same order as in core.
+   */
+  std::vector<Node> reduce(const std::vector<Node>& core,
+                           const std::vector<Node>& ecore);
+
+ private:
+  /**
+   * Check the satisfiability of the subset s of the core. If the result is
+   * UNSAT, then subcore is set to an unsatisfiable subset of s.
+   */
+  Result::Sat check(const std::vector<bool>& s, std::vector<bool>& subcore);
+  /** Get the cached result for the subset s, and subcore as for check */
+  Result::Sat lookup(const std::vector<bool>& s,
+                     std::vector<bool>& subcore) const;
+  /** Reduce the unsatisfiable subset s of the core by deletion */
+  void reduceDeletion(std::vector<bool>& s);
+  /**
+   * Returns a minimal subset c of t such that b and c are unsatisfiable,
+   * assuming that b and t are unsatisfiable. The flag hasDelta is true if
+   * assertions were added to b by the caller, in which case b may already be
+   * unsatisfiable. The subset b is restored before returning.
+   */
+  std::vector<size_t> quickXplain(std::vector<bool>& b,
+                                  bool hasDelta,
+                                  const std::vector<size_t>& t);
+  /** Print a warning if a check had an unknown result */
+  void warnUnknown();
+  /** The maximal number of satisfiable subsets that are cached */
+  static constexpr size_t s_maxSatCacheSize = 64;
+  /** The assertions of the core, with definitions expanded */
+  std::vector<Node> d_assertions;
+  /** Whether subsolvers compute unsat cores */
+  bool d_refine;
+  /** The unsatisfiable subsets, as lists of indices */
+  std::vector<std::vector<size_t>> d_unsatCache;
+  /** The most recent satisfiable subsets */
+  std::vector<std::vector<bool>> d_satCache;
+  /** Whether we have warned about an unknown result */
+  bool d_warnedUnknown;
+  /** Number of subsolver checks */
+  IntStat d_numChecks;
+  /** Number of checks answered by the cache */
+  IntStat d_numCacheHits;
+  /** Number of assertions removed by unsat cores of subsolvers */
+  IntStat d_numRefined;
+};
+
+}  // namespace smt
+}  // namespace cvc5
+
+#endif
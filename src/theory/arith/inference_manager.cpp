@@ -30,7 +30,11 @@ InferenceManager::InferenceManager(Env& env,
     : InferenceManagerBuffered(env, ta, astate, "theory::arith::"),
       // currently must track propagated literals if using the equality solver
       d_trackPropLits(options().arith.arithEqSolver),
-      d_propLits(context())
+      d_propLits(context()),
+      d_numDuplicateLemmas(0),
+      d_numEntailedConflicts(0),
+      d_duplicateIdStats(statisticsRegistry().registerHistogram<InferenceId>(
+          "theory::arith::inferencesDuplicateLemma"))
 {
 }
 
@@ -41,10 +45,13 @@ void InferenceManager::addPendingLemma(std::unique_ptr<SimpleTheoryLemma> lemma,
                          << (isWaiting ? " as waiting" : "") << std::endl;
   if (hasCachedLemma(lemma->d_node, lemma->d_property))
   {
+    ++d_numDuplicateLemmas;
+    d_duplicateIdStats << lemma->getId();
     return;
   }
   if (isEntailedFalse(*lemma))
   {
+    ++d_numEntailedConflicts;
     if (isWaiting)
     {
       d_waitingLem.clear();
@@ -113,6 +120,16 @@ std::size_t InferenceManager::numWaitingLemmas() const
   return d_waitingLem.size();
 }
 
+std::size_t InferenceManager::numDuplicateLemmas() const
+{
+  return d_numDuplicateLemmas;
+}
+
+std::size_t InferenceManager::numEntailedConflicts() const
+{
+  return d_numEntailedConflicts;
+}
+
 bool InferenceManager::hasCachedLemma(TNode lem, LemmaProperty p)
 {
   Node rewritten = rewrite(lem);
@@ -22,6 +22,7 @@
 
 #include "theory/inference_id.h"
 #include "theory/inference_manager_buffered.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 namespace theory {
@@ -95,6 +96,17 @@ class InferenceManager : public InferenceManagerBuffered
   /** Returns the number of pending lemmas. */
   std::size_t numWaitingLemmas() const;
 
+  /**
+   * Returns the number of lemmas that were dropped by addPendingLemma()
+   * because they were already cached.
+   */
+  std::size_t numDuplicateLemmas() const;
+  /**
+   * Returns the number of lemmas that were entailed to be false when they
+   * were added by addPendingLemma().
+   */
+  std::size_t numEntailedConflicts() const;
+
   /** Checks whether the given lemma is already present in the cache. */
   virtual bool hasCachedLemma(TNode lem, LemmaProperty p) override;
   /** overrides propagateLit to track which literals have been propagated */
@@ -124,6 +136,12 @@ class InferenceManager : public InferenceManagerBuffered
   bool d_trackPropLits;
   /** The literals we have propagated */
   NodeSet d_propLits;
+  /** The number of lemmas dropped as duplicates */
+  std::size_t d_numDuplicateLemmas;
+  /** The number of lemmas entailed to be false */
+  std::size_t d_numEntailedConflicts;
+  /** The inference ids of lemmas dropped as duplicates */
+  HistogramStat<InferenceId> d_duplicateIdStats;
 };
 
 }  // namespace arith
@@ -206,6 +206,8 @@ public:
 
   uint32_t size() const{ return d_size; }
   uint32_t capacity() const{ return d_entries.capacity(); }
+  /** The number of entries allocated so far, including freed ones. */
+  uint32_t numSlots() const { return d_entries.size(); }
 
 
 private:
@@ -395,10 +397,19 @@ protected:
   uint32_t d_entriesInUse;
   MatrixEntryVector<T> d_entries;
 
+  /* The number of entries added since the last call to compactEntries(). */
+  uint32_t d_entriesAddedSinceCompaction;
+
   std::vector<RowIndex> d_pool;
 
   T d_zero;
 
+  /*
+   * Do not compact the entries of matrices with fewer entries than this.
+   * This threshold has not been tuned on large tableaux yet.
+   */
+  static constexpr uint32_t s_minEntriesForCompaction = 1 << 14;
+
 public:
   /**
    * Constructs an empty Matrix.
@@ -410,6 +421,7 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesAddedSinceCompaction(0),
     d_zero(0)
   {}
 
@@ -420,6 +432,7 @@ public:
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesAddedSinceCompaction(0),
     d_zero(zero)
   {}
 
@@ -430,6 +443,7 @@ public:
     d_rowInMergeBuffer(m.d_rowInMergeBuffer),
     d_entriesInUse(m.d_entriesInUse),
     d_entries(m.d_entries),
+    d_entriesAddedSinceCompaction(m.d_entriesAddedSinceCompaction),
     d_zero(m.d_zero)
   {
     d_columns.clear();
@@ -449,6 +463,7 @@ public:
     d_rowInMergeBuffer = (m.d_rowInMergeBuffer);
     d_entriesInUse = (m.d_entriesInUse);
     d_entries = (m.d_entries);
+    d_entriesAddedSinceCompaction = m.d_entriesAddedSinceCompaction;
     d_zero = (m.d_zero);
     d_columns.clear();
     for(typename ColumnTable::const_iterator c=m.d_columns.begin(), cend = m.d_columns.end(); c!=cend; ++c){
@@ -479,6 +494,7 @@ protected:
     Assert(newEntry.getCoefficient() != 0);
 
     ++d_entriesInUse;
+    ++d_entriesAddedSinceCompaction;
 
     d_rows[row].insert(newId);
     d_columns[col].insert(newId);
@@ -902,6 +918,98 @@ public:
     releaseRowIndex(rid);
   }
 
+  /**
+   * Returns true if enough entries were added since the last compaction that
+   * the entries of a row are likely scattered over the entry vector, i.e. the
+   * cost of compactEntries() is amortized over the additions.
+   */
+  bool shouldCompactEntries() const
+  {
+    return d_entriesAddedSinceCompaction > s_minEntriesForCompaction
+           && d_entriesAddedSinceCompaction > d_entriesInUse;
+  }
+
+  /**
+   * Renumbers the entries such that the entries of every row are stored
+   * contiguously and in row order, rows being stored in increasing order of
+   * their indices. Freed entries are dropped. This makes traversals of rows
+   * (e.g. in pivoting and loadSignQueries()) walk linearly through memory,
+   * similar to a compressed row storage, while columns remain linked lists
+   * over the same entries.
+   *
+   * All EntryIDs obtained before this call are invalidated, hence the merge
+   * buffer must be empty.
+   */
+  void compactEntries()
+  {
+    Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
+    Assert(d_mergeBuffer.empty());
+    Debug("tableau") << "compactEntries(" << d_entriesInUse << " of "
+                     << d_entries.numSlots() << ")" << std::endl;
+
+    std::vector<EntryID> remap(d_entries.numSlots(), ENTRYID_SENTINEL);
+    MatrixEntryVector<T> compacted;
+    std::vector<EntryID> rowHeads(d_rows.size(), ENTRYID_SENTINEL);
+    for (RowIndex rid = 0, N = d_rows.size(); rid < N; ++rid)
+    {
+      EntryID prev = ENTRYID_SENTINEL;
+      for (RowIterator i = getRow(rid).begin(); !i.atEnd(); ++i)
+      {
+        EntryID newId = compacted.newEntry();
+        remap[i.getID()] = newId;
+        Entry& entry = compacted.get(newId);
+        entry = *i;
+        entry.setNextRowEntryID(ENTRYID_SENTINEL);
+        entry.setPrevRowEntryID(prev);
+        if (prev == ENTRYID_SENTINEL)
+        {
+          rowHeads[rid] = newId;
+        }
+        else
+        {
+          compacted.get(prev).setNextRowEntryID(newId);
+        }
+        prev = newId;
+      }
+    }
+    std::vector<EntryID> colHeads(d_columns.size(), ENTRYID_SENTINEL);
+    for (ArithVar v = 0, N = d_columns.size(); v < N; ++v)
+    {
+      EntryID prev = ENTRYID_SENTINEL;
+      for (ColIterator i = getColumn(v).begin(); !i.atEnd(); ++i)
+      {
+        EntryID newId = remap[i.getID()];
+        Assert(newId != ENTRYID_SENTINEL);
+        Entry& entry = compacted.get(newId);
+        entry.setNextColEntryID(ENTRYID_SENTINEL);
+        entry.setPrevColEntryID(prev);
+        if (prev == ENTRYID_SENTINEL)
+        {
+          colHeads[v] = newId;
+        }
+        else
+        {
+          compacted.get(prev).setNextColEntryID(newId);
+        }
+        prev = newId;
+      }
+    }
+    Assert(compacted.size() == d_entriesInUse);
+
+    d_entries = std::move(compacted);
+    for (RowIndex rid = 0, N = d_rows.size(); rid < N; ++rid)
+    {
+      d_rows[rid] =
+          RowVectorT(rowHeads[rid], d_rows[rid].getSize(), &d_entries);
+    }
+    for (ArithVar v = 0, N = d_columns.size(); v < N; ++v)
+    {
+      d_columns[v] =
+          ColumnVectorT(colHeads[v], d_columns[v].getSize(), &d_entries);
+    }
+    d_entriesAddedSinceCompaction = 0;
+  }
+
   double densityMeasure() const{
     Assert(numNonZeroEntriesByRow() == numNonZeroEntries());
     Assert(numNonZeroEntriesByCol() == numNonZeroEntries());
@@ -44,7 +44,9 @@ namespace nl {
 namespace cad {
 
 CDCAC::CDCAC(Env& env, const std::vector<poly::Variable>& ordering)
-    : EnvObj(env), d_variableOrdering(ordering)
+    : EnvObj(env),
+      d_variableOrdering(ordering),
+      d_cache(statisticsRegistry())
 {
   if (d_env.isTheoryProofProducing())
   {
@@ -58,13 +60,20 @@ void CDCAC::reset()
   d_constraints.reset();
   d_assignment.clear();
   d_nextIntervalId = 1;
+  d_cache.clearAssignments();
 }
 
 void CDCAC::computeVariableOrdering()
 {
   // Actually compute the variable ordering
-  d_variableOrdering = d_varOrder(d_constraints.getConstraints(),
-                                  VariableOrderingStrategy::BROWN);
+  std::vector<poly::Variable> ordering = d_varOrder(
+      d_constraints.getConstraints(), VariableOrderingStrategy::BROWN);
+  if (ordering != d_variableOrdering)
+  {
+    // Cached results depend on the main variables of the polynomials
+    d_cache.clear();
+    d_variableOrdering = std::move(ordering);
+  }
   Trace("cdcac") << "Variable ordering is now " << d_variableOrdering
                  << std::endl;
 
@@ -291,6 +300,17 @@ PolyVector requiredCoefficientsLazardModified(
 }  // namespace
 
 PolyVector CDCAC::requiredCoefficients(const poly::Polynomial& p)
+{
+  ProjectionCache::AssignmentKey key;
+  if (getCacheKey(p, key))
+  {
+    return d_cache.requiredCoefficients(
+        key, [this, &p]() { return requiredCoefficientsUncached(p); });
+  }
+  return requiredCoefficientsUncached(p);
+}
+
+PolyVector CDCAC::requiredCoefficientsUncached(const poly::Polynomial& p)
 {
   if (Trace.isOn("cdcac::projection"))
   {
@@ -348,10 +368,11 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
     }
     for (const auto& p : i.d_mainPolys)
     {
+      poly::Polynomial disc = discriminant(p);
       Trace("cdcac::projection")
-          << "Discriminant of " << p << " -> " << discriminant(p) << std::endl;
+          << "Discriminant of " << p << " -> " << disc << std::endl;
       // Add all discriminants
-      res.add(discriminant(p));
+      res.add(disc);
 
       for (const auto& q : requiredCoefficients(p))
       {
@@ -365,18 +386,20 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
         if (p == q) continue;
         // Check whether p(s \times a) = 0 for some a <= l
         if (!hasRootBelow(q, get_lower(i.d_interval))) continue;
+        poly::Polynomial r = resultant(p, q);
         Trace("cdcac::projection") << "Resultant of " << p << " and " << q
-                                   << " -> " << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+                                   << " -> " << r << std::endl;
+        res.add(r);
       }
       for (const auto& q : i.d_upperPolys)
       {
         if (p == q) continue;
         // Check whether p(s \times a) = 0 for some a >= u
         if (!hasRootAbove(q, get_upper(i.d_interval))) continue;
+        poly::Polynomial r = resultant(p, q);
         Trace("cdcac::projection") << "Resultant of " << p << " and " << q
-                                   << " -> " << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+                                   << " -> " << r << std::endl;
+        res.add(r);
       }
     }
   }
@@ -388,9 +411,10 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
     {
       for (const auto& q : intervals[i + 1].d_lowerPolys)
       {
+        poly::Polynomial r = resultant(p, q);
         Trace("cdcac::projection") << "Resultant of " << p << " and " << q
-                                   << " -> " << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+                                   << " -> " << r << std::endl;
+        res.add(r);
       }
     }
   }
@@ -681,19 +705,17 @@ CACInterval CDCAC::buildIntegralityInterval(std::size_t cur_variable,
                      {}};
 }
 
-bool CDCAC::hasRootAbove(const poly::Polynomial& p,
-                         const poly::Value& val) const
+bool CDCAC::hasRootAbove(const poly::Polynomial& p, const poly::Value& val)
 {
-  auto roots = poly::isolate_real_roots(p, d_assignment);
+  auto roots = isolateRealRootsRegular(p);
   return std::any_of(roots.begin(), roots.end(), [&val](const poly::Value& r) {
     return r >= val;
   });
 }
 
-bool CDCAC::hasRootBelow(const poly::Polynomial& p,
-                         const poly::Value& val) const
+bool CDCAC::hasRootBelow(const poly::Polynomial& p, const poly::Value& val)
 {
-  auto roots = poly::isolate_real_roots(p, d_assignment);
+  auto roots = isolateRealRootsRegular(p);
   return std::any_of(roots.begin(), roots.end(), [&val](const poly::Value& r) {
     return r <= val;
   });
@@ -748,16 +770,74 @@ void CDCAC::prepareRootIsolation(LazardEvaluation& le,
   }
 }
 
-std::vector<poly::Value> CDCAC::isolateRealRoots(
-    LazardEvaluation& le, const poly::Polynomial& p) const
+std::vector<poly::Value> CDCAC::isolateRealRoots(LazardEvaluation& le,
+                                                 const poly::Polynomial& p)
 {
   if (options().arith.nlCadLifting == options::NlCadLiftingMode::LAZARD)
   {
     return le.isolateRealRoots(p);
   }
+  return isolateRealRootsRegular(p);
+}
+
+std::vector<poly::Value> CDCAC::isolateRealRootsRegular(
+    const poly::Polynomial& p)
+{
+  ProjectionCache::AssignmentKey key;
+  if (getCacheKey(p, key))
+  {
+    return d_cache.realRoots(key, [this, &p]() {
+      return poly::isolate_real_roots(p, d_assignment);
+    });
+  }
   return poly::isolate_real_roots(p, d_assignment);
 }
 
+poly::Polynomial CDCAC::discriminant(const poly::Polynomial& p)
+{
+  if (options().arith.nlCadCache)
+  {
+    return d_cache.discriminant(p);
+  }
+  return poly::discriminant(p);
+}
+
+poly::Polynomial CDCAC::resultant(const poly::Polynomial& p,
+                                  const poly::Polynomial& q)
+{
+  if (options().arith.nlCadCache)
+  {
+    return d_cache.resultant(p, q);
+  }
+  return poly::resultant(p, q);
+}
+
+bool CDCAC::getCacheKey(const poly::Polynomial& p,
+                        ProjectionCache::AssignmentKey& key) const
+{
+  if (!options().arith.nlCadCache)
+  {
+    return false;
+  }
+  poly::Variable mainVar = main_variable(p);
+  key.first = p;
+  key.second.clear();
+  for (const auto& v : d_variableOrdering)
+  {
+    if (v == mainVar)
+    {
+      return true;
+    }
+    if (!d_assignment.has(v))
+    {
+      return false;
+    }
+    key.second.emplace_back(d_assignment.get(v));
+  }
+  // the main variable is not part of the variable ordering
+  return false;
+}
+
 }  // namespace cad
 }  // namespace nl
 }  // namespace arith
@@ -30,6 +30,7 @@
 #include "theory/arith/nl/cad/cdcac_utils.h"
 #include "theory/arith/nl/cad/constraints.h"
 #include "theory/arith/nl/cad/lazard_evaluation.h"
+#include "theory/arith/nl/cad/projection_cache.h"
 #include "theory/arith/nl/cad/proof_generator.h"
 #include "theory/arith/nl/cad/variable_ordering.h"
 
@@ -182,12 +183,12 @@ class CDCAC : protected EnvObj
    * Check whether the polynomial has a real root above the given value (when
    * evaluated over the current assignment).
    */
-  bool hasRootAbove(const poly::Polynomial& p, const poly::Value& val) const;
+  bool hasRootAbove(const poly::Polynomial& p, const poly::Value& val);
   /**
    * Check whether the polynomial has a real root below the given value (when
    * evaluated over the current assignment).
    */
-  bool hasRootBelow(const poly::Polynomial& p, const poly::Value& val) const;
+  bool hasRootBelow(const poly::Polynomial& p, const poly::Value& val);
 
   /**
    * Sort intervals according to section 4.4.1. and removes fully redundant
@@ -208,7 +209,34 @@ class CDCAC : protected EnvObj
    * regular `poly::isolate_real_roots()`.
    */
   std::vector<poly::Value> isolateRealRoots(LazardEvaluation& le,
-                                            const poly::Polynomial& p) const;
+                                            const poly::Polynomial& p);
+
+  /**
+   * Isolates the real roots of the polynomial `p` over the current assignment
+   * using `poly::isolate_real_roots()`. The result is cached if the cache is
+   * enabled.
+   */
+  std::vector<poly::Value> isolateRealRootsRegular(const poly::Polynomial& p);
+
+  /**
+   * Computes the required coefficients as in requiredCoefficients(), but
+   * without consulting the cache.
+   */
+  PolyVector requiredCoefficientsUncached(const poly::Polynomial& p);
+
+  /** Computes the discriminant of p, using the cache if enabled. */
+  poly::Polynomial discriminant(const poly::Polynomial& p);
+  /** Computes the resultant of p and q, using the cache if enabled. */
+  poly::Polynomial resultant(const poly::Polynomial& p,
+                             const poly::Polynomial& q);
+
+  /**
+   * Constructs the key for the cache from `p` and the values assigned to all
+   * variables below the main variable of `p`. Returns false if the cache is
+   * disabled or any of these variables is unassigned.
+   */
+  bool getCacheKey(const poly::Polynomial& p,
+                   ProjectionCache::AssignmentKey& key) const;
 
   /**
    * The current assignment. When the method terminates with SAT, it contains a
@@ -233,6 +261,9 @@ class CDCAC : protected EnvObj
 
   /** The next interval id */
   size_t d_nextIntervalId = 1;
+
+  /** The cache for projection and root isolation results */
+  ProjectionCache d_cache;
 };
 
 }  // namespace cad
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implements a cache for projection operations and real root isolation used
+ * by the CDCAC method.
+ */
+
+#include "theory/arith/nl/cad/projection_cache.h"
+
+#ifdef CVC5_POLY_IMP
+
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace cad {
+
+ProjectionCache::ProjectionCache(StatisticsRegistry& reg)
+    : d_discriminantHits(
+          reg.registerInt("theory::arith::nl::cad::cache::discriminantHits")),
+      d_discriminantMisses(
+          reg.registerInt("theory::arith::nl::cad::cache::discriminantMisses")),
+      d_resultantHits(
+          reg.registerInt("theory::arith::nl::cad::cache::resultantHits")),
+      d_resultantMisses(
+          reg.registerInt("theory::arith::nl::cad::cache::resultantMisses")),
+      d_coefficientHits(
+          reg.registerInt("theory::arith::nl::cad::cache::coefficientHits")),
+      d_coefficientMisses(
+          reg.registerInt("theory::arith::nl::cad::cache::coefficientMisses")),
+      d_rootHits(reg.registerInt("theory::arith::nl::cad::cache::rootHits")),
+      d_rootMisses(
+          reg.registerInt("theory::arith::nl::cad::cache::rootMisses")),
+      d_clears(reg.registerInt("theory::arith::nl::cad::cache::clears"))
+{
+}
+
+void ProjectionCache::clear()
+{
+  ++d_clears;
+  d_discriminants.clear();
+  d_resultants.clear();
+  d_coefficients.clear();
+  d_roots.clear();
+}
+
+void ProjectionCache::clearAssignments()
+{
+  d_coefficients.clear();
+  d_roots.clear();
+}
+
+const poly::Polynomial& ProjectionCache::discriminant(
+    const poly::Polynomial& p)
+{
+  auto it = d_discriminants.find(p);
+  if (it != d_discriminants.end())
+  {
+    ++d_discriminantHits;
+    return it->second;
+  }
+  ++d_discriminantMisses;
+  return d_discriminants.emplace(p, poly::discriminant(p)).first->second;
+}
+
+const poly::Polynomial& ProjectionCache::resultant(const poly::Polynomial& p,
+                                                   const poly::Polynomial& q)
+{
+  auto key = std::make_pair(p, q);
+  auto it = d_resultants.find(key);
+  if (it != d_resultants.end())
+  {
+    ++d_resultantHits;
+    return it->second;
+  }
+  ++d_resultantMisses;
+  return d_resultants.emplace(key, poly::resultant(p, q)).first->second;
+}
+
+const PolyVector& ProjectionCache::requiredCoefficients(
+    const AssignmentKey& key, const std::function<PolyVector()>& compute)
+{
+  auto it = d_coefficients.find(key);
+  if (it != d_coefficients.end())
+  {
+    ++d_coefficientHits;
+    return it->second;
+  }
+  ++d_coefficientMisses;
+  return d_coefficients.emplace(key, compute()).first->second;
+}
+
+const std::vector<poly::Value>& ProjectionCache::realRoots(
+    const AssignmentKey& key,
+    const std::function<std::vector<poly::Value>()>& compute)
+{
+  auto it = d_roots.find(key);
+  if (it != d_roots.end())
+  {
+    ++d_rootHits;
+    return it->second;
+  }
+  ++d_rootMisses;
+  return d_roots.emplace(key, compute()).first->second;
+}
+
+}  // namespace cad
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implements a cache for projection operations and real root isolation used
+ * by the CDCAC method.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__ARITH__NL__CAD__PROJECTION_CACHE_H
+#define CVC5__THEORY__ARITH__NL__CAD__PROJECTION_CACHE_H
+
+#ifdef CVC5_POLY_IMP
+
+#include <poly/polyxx.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "theory/arith/nl/cad/projections.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+
+class StatisticsRegistry;
+
+namespace theory {
+namespace arith {
+namespace nl {
+namespace cad {
+
+/**
+ * Caches the results of the expensive algebraic operations of the CDCAC
+ * method, so that they can be reused across multiple checks. This is most
+ * beneficial in incremental usage, where most constraints survive from one
+ * check to the next.
+ *
+ * Discriminants and resultants only depend on the polynomials themselves.
+ * Required coefficients and real roots additionally depend on the values
+ * assigned to the variables below the main variable of the polynomial, which
+ * are part of the key.
+ *
+ * All results depend on the current variable ordering (that determines the
+ * main variable of every polynomial), hence the cache needs to be cleared
+ * whenever the variable ordering changes.
+ *
+ * The assignment changes in almost every check, so the results that depend
+ * on it are rarely reused across checks. They are dropped by
+ * clearAssignments at the start of every check, so that they do not grow
+ * without bound in incremental usage.
+ */
+class ProjectionCache
+{
+ public:
+  /**
+   * A polynomial together with the values of all variables below its main
+   * variable.
+   */
+  using AssignmentKey = std::pair<poly::Polynomial, std::vector<poly::Value>>;
+
+  ProjectionCache(StatisticsRegistry& reg);
+
+  /** Remove all cached results. */
+  void clear();
+  /** Remove the cached results that depend on an assignment. */
+  void clearAssignments();
+
+  /** Returns the (cached) discriminant of p. */
+  const poly::Polynomial& discriminant(const poly::Polynomial& p);
+  /** Returns the (cached) resultant of p and q. */
+  const poly::Polynomial& resultant(const poly::Polynomial& p,
+                                    const poly::Polynomial& q);
+  /**
+   * Returns the required coefficients for the given key, using compute to
+   * obtain them if they are not cached yet.
+   */
+  const PolyVector& requiredCoefficients(
+      const AssignmentKey& key, const std::function<PolyVector()>& compute);
+  /**
+   * Returns the real roots for the given key, using compute to obtain them if
+   * they are not cached yet.
+   */
+  const std::vector<poly::Value>& realRoots(
+      const AssignmentKey& key,
+      const std::function<std::vector<poly::Value>()>& compute);
+
+ private:
+  /** Cache for discriminants */
+  std::map<poly::Polynomial, poly::Polynomial> d_discriminants;
+  /** Cache for resultants */
+  std::map<std::pair<poly::Polynomial, poly::Polynomial>, poly::Polynomial>
+      d_resultants;
+  /** Cache for required coefficients */
+  std::map<AssignmentKey, PolyVector> d_coefficients;
+  /** Cache for real root isolations */
+  std::map<AssignmentKey, std::vector<poly::Value>> d_roots;
+
+  /** Number of cache hits for discriminants */
+  IntStat d_discriminantHits;
+  /** Number of cache misses for discriminants */
+  IntStat d_discriminantMisses;
+  /** Number of cache hits for resultants */
+  IntStat d_resultantHits;
+  /** Number of cache misses for resultants */
+  IntStat d_resultantMisses;
+  /** Number of cache hits for required coefficients */
+  IntStat d_coefficientHits;
+  /** Number of cache misses for required coefficients */
+  IntStat d_coefficientMisses;
+  /** Number of cache hits for real root isolations */
+  IntStat d_rootHits;
+  /** Number of cache misses for real root isolations */
+  IntStat d_rootMisses;
+  /** Number of times the cache was cleared */
+  IntStat d_clears;
+};
+
+}  // namespace cad
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
+
+#endif
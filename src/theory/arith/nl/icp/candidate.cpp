@@ -18,6 +18,7 @@
 #ifdef CVC5_POLY_IMP
 
 #include <iostream>
+#include <limits>
 
 #include "base/check.h"
 #include "base/output.h"
@@ -105,6 +106,34 @@ PropagationResult Candidate::propagate(poly::IntervalAssignment& ia,
   return result;
 }
 
+bool Candidate::mayContract(const poly::IntervalAssignment& ia) const
+{
+  FPInterval inner = rhsfp.evaluateInner(ia);
+  if (!(inner.lower <= inner.upper))
+  {
+    return true;
+  }
+  const poly::Interval& cur = ia.get(lhs);
+  Trace("nl-icp") << "FP prop: " << *this << " -> " << inner << " vs " << cur
+                  << std::endl;
+  // The exact result of the evaluation contains inner. A bound of cur can
+  // only be contracted if it is finite and not strictly covered by inner.
+  FPInterval curfp = toFPInterval(cur);
+  bool lowerCovered =
+      is_minus_infinity(get_lower(cur)) || inner.lower < curfp.lower;
+  bool upperCovered =
+      is_plus_infinity(get_upper(cur)) || inner.upper > curfp.upper;
+  switch (rel)
+  {
+    case poly::SignCondition::LT:
+    case poly::SignCondition::LE: return !upperCovered;
+    case poly::SignCondition::GT:
+    case poly::SignCondition::GE: return !lowerCovered;
+    case poly::SignCondition::EQ: return !lowerCovered || !upperCovered;
+    default: return true;
+  }
+}
+
 std::ostream& operator<<(std::ostream& os, const Candidate& c)
 {
   os << c.lhs << " " << c.rel << " ";
@@ -22,6 +22,7 @@
 #include <poly/polyxx.h>
 
 #include "expr/node.h"
+#include "theory/arith/nl/icp/fp_interval.h"
 #include "theory/arith/nl/icp/intersection.h"
 
 namespace cvc5 {
@@ -62,6 +63,18 @@ struct Candidate
   Node origin;
   /** The variable within rhs */
   std::vector<Node> rhsVariables;
+  /** rhsmult*rhs, prepared for floating-point evaluation */
+  FPPolynomial rhsfp;
+
+  /**
+   * Checks whether propagating this candidate may contract the interval
+   * assignment, using floating-point interval arithmetic only. If this method
+   * returns false, an inner approximation of the range of rhs strictly covers
+   * the bounds of the current interval of lhs that propagate() would update,
+   * hence the exact result does as well and propagate() can safely be
+   * skipped.
+   */
+  bool mayContract(const poly::IntervalAssignment& ia) const;
 
   /**
    * Contract the interval assignment based on this candidate.
@@ -0,0 +1,315 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Floating-point interval arithmetic with outward rounding.
+ */
+
+#include "theory/arith/nl/icp/fp_interval.h"
+
+#ifdef CVC5_POLY_IMP
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+namespace {
+
+constexpr double s_inf = std::numeric_limits<double>::infinity();
+
+/**
+ * Turn the (possibly rounded) result x into a lower bound by moving it one
+ * step towards minus infinity. NaN becomes minus infinity.
+ */
+double roundDown(double x)
+{
+  if (std::isnan(x)) return -s_inf;
+  return std::nextafter(x, -s_inf);
+}
+/**
+ * Turn the (possibly rounded) result x into an upper bound by moving it one
+ * step towards plus infinity. NaN becomes plus infinity.
+ */
+double roundUp(double x)
+{
+  if (std::isnan(x)) return s_inf;
+  return std::nextafter(x, s_inf);
+}
+
+/** Multiply two bounds, using 0 * inf = 0 as usual in interval arithmetic. */
+double mulBound(double a, double b)
+{
+  if (a == 0 || b == 0) return 0;
+  return a * b;
+}
+
+/** Computes a lower bound for x^n, assuming x >= 0 */
+double powDown(double x, std::size_t n)
+{
+  double res = 1;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    res = std::max(0.0, roundDown(mulBound(res, x)));
+  }
+  return res;
+}
+/** Computes an upper bound for x^n, assuming x >= 0 */
+double powUp(double x, std::size_t n)
+{
+  double res = 1;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    res = roundUp(mulBound(res, x));
+  }
+  return res;
+}
+
+/**
+ * Converts v to a double. The result is either exact or off by less than one
+ * ulp. Returns NaN if v is an algebraic number, as the conversion is only an
+ * approximation in this case.
+ */
+double toDouble(const poly::Value& v)
+{
+  if (is_minus_infinity(v)) return -s_inf;
+  if (is_plus_infinity(v)) return s_inf;
+  if (v.get_internal()->type == LP_VALUE_ALGEBRAIC)
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return lp_value_to_double(v.get_internal());
+}
+
+/** The data collectFPMonomial() works on */
+struct FPPolynomialData
+{
+  /** The monomials of the polynomial */
+  std::vector<FPMonomial>* monomials;
+  /** The variables of the polynomial */
+  std::vector<lp_variable_t>* vars;
+};
+
+/**
+ * Callback for lp_polynomial_traverse. Assumes data is actually an
+ * FPPolynomialData and adds the given monomial to it.
+ */
+void collectFPMonomial(const lp_polynomial_context_t* ctx,
+                       lp_monomial_t* m,
+                       void* data)
+{
+  auto* fpp = static_cast<FPPolynomialData*>(data);
+  FPMonomial res;
+  res.d_coeff = toFPInterval(poly::Value(poly::Integer(&m->a)));
+  for (std::size_t i = 0; i < m->n; ++i)
+  {
+    auto it = std::find(fpp->vars->begin(), fpp->vars->end(), m->p[i].x);
+    std::size_t index = it - fpp->vars->begin();
+    if (it == fpp->vars->end())
+    {
+      fpp->vars->emplace_back(m->p[i].x);
+    }
+    res.d_powers.emplace_back(index, m->p[i].d);
+  }
+  fpp->monomials->emplace_back(std::move(res));
+}
+
+/**
+ * Computes the points of the interval i that evaluateInner() uses for its
+ * variable, i.e. its finite bounds, or zero if i is unbounded. Every point is
+ * given as an FPInterval that contains it. Returns false if a bound is an
+ * algebraic number, which we do not convert to an FPInterval.
+ */
+bool getPoints(const poly::Interval& i, std::vector<FPInterval>& points)
+{
+  for (const poly::Value* v : {&get_lower(i), &get_upper(i)})
+  {
+    if (is_minus_infinity(*v) || is_plus_infinity(*v))
+    {
+      continue;
+    }
+    if (v->get_internal()->type == LP_VALUE_ALGEBRAIC)
+    {
+      return false;
+    }
+    points.emplace_back(toFPInterval(*v));
+  }
+  if (points.empty())
+  {
+    points.emplace_back(FPInterval{0, 0});
+  }
+  return true;
+}
+
+}  // namespace
+
+FPInterval toFPInterval(const poly::Interval& i)
+{
+  return FPInterval{roundDown(toDouble(get_lower(i))),
+                    roundUp(toDouble(get_upper(i)))};
+}
+
+FPInterval toFPInterval(const poly::Value& v)
+{
+  double d = toDouble(v);
+  return FPInterval{roundDown(d), roundUp(d)};
+}
+
+FPInterval operator+(const FPInterval& a, const FPInterval& b)
+{
+  return FPInterval{roundDown(a.lower + b.lower), roundUp(a.upper + b.upper)};
+}
+
+FPInterval operator*(const FPInterval& a, const FPInterval& b)
+{
+  double p[4] = {mulBound(a.lower, b.lower),
+                 mulBound(a.lower, b.upper),
+                 mulBound(a.upper, b.lower),
+                 mulBound(a.upper, b.upper)};
+  return FPInterval{roundDown(*std::min_element(p, p + 4)),
+                    roundUp(*std::max_element(p, p + 4))};
+}
+
+FPInterval pow(const FPInterval& a, std::size_t n)
+{
+  if (n == 0)
+  {
+    return FPInterval{1, 1};
+  }
+  if (a.lower >= 0)
+  {
+    return FPInterval{powDown(a.lower, n), powUp(a.upper, n)};
+  }
+  bool even = (n % 2 == 0);
+  if (a.upper <= 0)
+  {
+    double lower = powDown(-a.upper, n);
+    double upper = powUp(-a.lower, n);
+    if (even)
+    {
+      return FPInterval{lower, upper};
+    }
+    return FPInterval{-upper, -lower};
+  }
+  // zero is in the interior of a
+  if (even)
+  {
+    return FPInterval{0, std::max(powUp(-a.lower, n), powUp(a.upper, n))};
+  }
+  return FPInterval{-powUp(-a.lower, n), powUp(a.upper, n)};
+}
+
+std::ostream& operator<<(std::ostream& os, const FPInterval& i)
+{
+  return os << '[' << i.lower << " .. " << i.upper << ']';
+}
+
+FPPolynomial::FPPolynomial(const poly::Polynomial& p,
+                           const poly::Rational& mult)
+    : d_mult(toFPInterval(poly::Value(mult)))
+{
+  std::vector<lp_variable_t> vars;
+  FPPolynomialData data{&d_monomials, &vars};
+  lp_polynomial_traverse(p.get_internal(), collectFPMonomial, &data);
+  for (lp_variable_t v : vars)
+  {
+    d_vars.emplace_back(v);
+  }
+}
+
+FPInterval FPPolynomial::evaluateInner(const poly::IntervalAssignment& ia) const
+{
+  FPInterval res{s_inf, -s_inf};
+  std::vector<std::vector<FPInterval>> points(d_vars.size());
+  std::size_t numPoints = 1;
+  for (std::size_t i = 0, n = d_vars.size(); i < n; ++i)
+  {
+    if (!ia.has(d_vars[i]))
+    {
+      points[i].emplace_back(FPInterval{0, 0});
+    }
+    else if (!getPoints(ia.get(d_vars[i]), points[i]))
+    {
+      return res;
+    }
+    numPoints = std::min(numPoints * points[i].size(), s_maxPoints + 1);
+  }
+  std::vector<FPInterval> point(d_vars.size());
+  auto addPoint = [this, &point, &res]() {
+    FPInterval val = evaluateAt(point);
+    res.lower = std::min(res.lower, val.upper);
+    res.upper = std::max(res.upper, val.lower);
+  };
+  if (numPoints > s_maxPoints)
+  {
+    // only use the points where all variables are at their lowest resp.
+    // highest point
+    for (std::size_t i = 0, n = d_vars.size(); i < n; ++i)
+    {
+      point[i] = points[i].front();
+    }
+    addPoint();
+    for (std::size_t i = 0, n = d_vars.size(); i < n; ++i)
+    {
+      point[i] = points[i].back();
+    }
+    addPoint();
+    return res;
+  }
+  // enumerate all combinations of points
+  std::vector<std::size_t> cur(d_vars.size(), 0);
+  while (true)
+  {
+    for (std::size_t i = 0, n = d_vars.size(); i < n; ++i)
+    {
+      point[i] = points[i][cur[i]];
+    }
+    addPoint();
+    std::size_t i = 0;
+    while (i < cur.size() && ++cur[i] == points[i].size())
+    {
+      cur[i++] = 0;
+    }
+    if (i == cur.size())
+    {
+      break;
+    }
+  }
+  return res;
+}
+
+FPInterval FPPolynomial::evaluateAt(const std::vector<FPInterval>& point) const
+{
+  FPInterval res{0, 0};
+  for (const auto& m : d_monomials)
+  {
+    FPInterval term = m.d_coeff;
+    for (const auto& vp : m.d_powers)
+    {
+      term = term * pow(point[vp.first], vp.second);
+    }
+    res = res + term;
+  }
+  return res * d_mult;
+}
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Floating-point interval arithmetic with outward rounding.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__ARITH__ICP__FP_INTERVAL_H
+#define CVC5__THEORY__ARITH__ICP__FP_INTERVAL_H
+
+#ifdef CVC5_POLY_IMP
+#include <poly/polyxx.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+/**
+ * A closed interval with double bounds, used as a cheap over-approximation of
+ * a poly::Interval. Infinite bounds are represented by the respective double
+ * infinities.
+ *
+ * All operations round outward, i.e. the result of an operation always
+ * contains the result of the respective exact operation on the represented
+ * intervals. Open bounds are over-approximated by closed bounds.
+ */
+struct FPInterval
+{
+  /** The lower bound */
+  double lower = -std::numeric_limits<double>::infinity();
+  /** The upper bound */
+  double upper = std::numeric_limits<double>::infinity();
+};
+
+/** Over-approximate the given interval by an FPInterval. */
+FPInterval toFPInterval(const poly::Interval& i);
+/** Over-approximate the point interval [v, v] by an FPInterval. */
+FPInterval toFPInterval(const poly::Value& v);
+
+/** Interval addition with outward rounding. */
+FPInterval operator+(const FPInterval& a, const FPInterval& b);
+/** Interval multiplication with outward rounding. */
+FPInterval operator*(const FPInterval& a, const FPInterval& b);
+/** Interval exponentiation with outward rounding. */
+FPInterval pow(const FPInterval& a, std::size_t n);
+
+/** Print an FPInterval */
+std::ostream& operator<<(std::ostream& os, const FPInterval& i);
+
+/**
+ * A monomial as a coefficient and a list of variable exponent pairs, where
+ * variables are given by their index in FPPolynomial::d_vars.
+ */
+struct FPMonomial
+{
+  /** The coefficient */
+  FPInterval d_coeff;
+  /** The variables and their exponents */
+  std::vector<std::pair<std::size_t, std::size_t>> d_powers;
+};
+
+/**
+ * A polynomial together with a rational multiplier (as used in Candidate),
+ * prepared for the evaluation in floating-point arithmetic. The coefficients
+ * are converted to FPIntervals once upon construction, such that evaluating
+ * the polynomial only uses hardware floating-point arithmetic.
+ */
+class FPPolynomial
+{
+ public:
+  FPPolynomial() = default;
+  /** Prepare mult * p for floating-point evaluation */
+  FPPolynomial(const poly::Polynomial& p, const poly::Rational& mult);
+
+  /**
+   * Computes an inner approximation of the range of this polynomial over the
+   * box given by the interval assignment ia: every value between the lower
+   * and the upper bound of the result is the value of this polynomial at some
+   * point of the closure of the box. The result is empty (its lower bound is
+   * greater than its upper bound) if no such interval was found.
+   *
+   * The polynomial is evaluated in outward rounding interval arithmetic at a
+   * few points of the box. As the box is connected, the range contains all
+   * values between the smallest and the largest value at these points.
+   */
+  FPInterval evaluateInner(const poly::IntervalAssignment& ia) const;
+
+ private:
+  /**
+   * Evaluate this polynomial at the point that maps d_vars[i] to a value
+   * within point[i], the result contains the exact value.
+   */
+  FPInterval evaluateAt(const std::vector<FPInterval>& point) const;
+  /** The maximal number of points evaluateInner() evaluates at */
+  static constexpr std::size_t s_maxPoints = 16;
+  /** The monomials of the polynomial */
+  std::vector<FPMonomial> d_monomials;
+  /** The variables of the polynomial */
+  std::vector<poly::Variable> d_vars;
+  /** The rational multiplier */
+  FPInterval d_mult;
+};
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
+
+#endif
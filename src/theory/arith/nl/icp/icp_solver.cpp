@@ -20,6 +20,7 @@
 #include "base/check.h"
 #include "base/output.h"
 #include "expr/node_algorithm.h"
+#include "options/arith_options.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/arith/inference_manager.h"
 #include "theory/arith/nl/poly_conversion.h"
@@ -66,7 +67,13 @@ inline std::ostream& operator<<(std::ostream& os, const IAWrapper& iaw)
 }  // namespace
 
 ICPSolver::ICPSolver(Env& env, InferenceManager& im)
-    : EnvObj(env), d_im(im), d_state(env, d_mapper)
+    : EnvObj(env),
+      d_im(im),
+      d_state(env, d_mapper),
+      d_fpFiltered(statisticsRegistry().registerInt(
+          "theory::arith::nl::icp::fpFiltered")),
+      d_exactPropagations(statisticsRegistry().registerInt(
+          "theory::arith::nl::icp::exactPropagations"))
 {
 }
 
@@ -133,7 +140,13 @@ std::vector<Candidate> ICPSolver::constructCandidates(const Node& n)
       {
         rhsmult = poly_utils::toRational(veq_c.getConst<Rational>());
       }
-      Candidate res{lhs, rel, rhs, rhsmult, n, collectVariables(val)};
+      Candidate res{lhs,
+                    rel,
+                    rhs,
+                    rhsmult,
+                    n,
+                    collectVariables(val),
+                    FPPolynomial(rhs, rhsmult)};
       Trace("nl-icp") << "\tAdded " << res << " from " << n << std::endl;
       result.emplace_back(res);
     }
@@ -158,7 +171,13 @@ std::vector<Candidate> ICPSolver::constructCandidates(const Node& n)
       {
         rhsmult = poly_utils::toRational(veq_c.getConst<Rational>());
       }
-      Candidate res{lhs, rel, rhs, rhsmult, n, collectVariables(val)};
+      Candidate res{lhs,
+                    rel,
+                    rhs,
+                    rhsmult,
+                    n,
+                    collectVariables(val),
+                    FPPolynomial(rhs, rhsmult)};
       Trace("nl-icp") << "\tAdded " << res << " from " << n << std::endl;
       result.emplace_back(res);
     }
@@ -225,6 +244,13 @@ PropagationResult ICPSolver::doPropagationRound()
   for (const auto& c : d_state.d_candidates)
   {
     --d_budget;
+    if (options().arith.nlICPFPFilter
+        && !c.mayContract(d_state.d_assignment))
+    {
+      ++d_fpFiltered;
+      continue;
+    }
+    ++d_exactPropagations;
     PropagationResult cres = c.propagate(d_state.d_assignment, 100);
     switch (cres)
     {
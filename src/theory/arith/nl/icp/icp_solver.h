@@ -29,6 +29,7 @@
 #include "theory/arith/nl/icp/contraction_origins.h"
 #include "theory/arith/nl/icp/intersection.h"
 #include "theory/arith/nl/poly_conversion.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 namespace theory {
@@ -113,6 +114,11 @@ class ICPSolver : protected EnvObj
   /** The budget increment for new candidates and strong contractions */
   static constexpr std::int64_t d_budgetIncrement = 10;
 
+  /** Number of propagations skipped by the floating-point filter */
+  IntStat d_fpFiltered;
+  /** Number of propagations done with exact arithmetic */
+  IntStat d_exactPropagations;
+
   /** Collect all variables from a node */
   std::vector<Node> collectVariables(const Node& n) const;
   /** Construct all possible candidates from a given theory atom */
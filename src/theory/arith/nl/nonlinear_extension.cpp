@@ -59,7 +59,8 @@ NonlinearExtension::NonlinearExtension(Env& env,
       d_cadSlv(d_env, d_im, d_model),
       d_icpSlv(d_env, d_im),
       d_iandSlv(env, d_im, state, d_model),
-      d_pow2Slv(env, d_im, state, d_model)
+      d_pow2Slv(env, d_im, state, d_model),
+      d_stepScores(statisticsRegistry())
 {
   d_extTheory.addFunctionKind(kind::NONLINEAR_MULT);
   d_extTheory.addFunctionKind(kind::EXPONENTIAL);
@@ -481,73 +482,20 @@ void NonlinearExtension::runStrategy(Theory::Effort effort,
     d_strategy.initializeStrategy(options());
   }
 
-  auto steps = d_strategy.getStrategy();
-  bool stop = false;
-  while (!stop && steps.hasNext())
+  std::vector<InferStep> skipped;
+  runSteps(d_strategy.getStrategy(), assertions, false_asserts, xts, skipped);
+  if (!skipped.empty() && !d_im.hasPendingLemma() && !d_im.hasWaitingLemma())
   {
-    InferStep step = steps.next();
-    Trace("nl-strategy") << "Step " << step << std::endl;
-    switch (step)
+    // We skipped dominated steps and found no lemma, run them after all. Their
+    // scores are not updated, since they were not chosen by the scores.
+    Trace("nl-strategy") << "Run skipped steps" << std::endl;
+    for (InferStep step : skipped)
     {
-      case InferStep::BREAK: stop = d_im.hasPendingLemma(); break;
-      case InferStep::FLUSH_WAITING_LEMMAS: d_im.flushWaitingLemmas(); break;
-      case InferStep::CAD_FULL: d_cadSlv.checkFull(); break;
-      case InferStep::CAD_INIT: d_cadSlv.initLastCall(assertions); break;
-      case InferStep::NL_FACTORING:
-        d_factoringSlv.check(assertions, false_asserts);
-        break;
-      case InferStep::IAND_INIT:
-        d_iandSlv.initLastCall(assertions, false_asserts, xts);
-        break;
-      case InferStep::IAND_FULL: d_iandSlv.checkFullRefine(); break;
-      case InferStep::IAND_INITIAL: d_iandSlv.checkInitialRefine(); break;
-      case InferStep::POW2_INIT:
-        d_pow2Slv.initLastCall(assertions, false_asserts, xts);
-        break;
-      case InferStep::POW2_FULL: d_pow2Slv.checkFullRefine(); break;
-      case InferStep::POW2_INITIAL: d_pow2Slv.checkInitialRefine(); break;
-      case InferStep::ICP:
-        d_icpSlv.reset(assertions);
-        d_icpSlv.check();
-        break;
-      case InferStep::NL_INIT:
-        d_extState.init(xts);
-        d_monomialBoundsSlv.init();
-        d_monomialSlv.init(xts);
-        break;
-      case InferStep::NL_MONOMIAL_INFER_BOUNDS:
-        d_monomialBoundsSlv.checkBounds(assertions, false_asserts);
-        break;
-      case InferStep::NL_MONOMIAL_MAGNITUDE0:
-        d_monomialSlv.checkMagnitude(0);
-        break;
-      case InferStep::NL_MONOMIAL_MAGNITUDE1:
-        d_monomialSlv.checkMagnitude(1);
-        break;
-      case InferStep::NL_MONOMIAL_MAGNITUDE2:
-        d_monomialSlv.checkMagnitude(2);
-        break;
-      case InferStep::NL_MONOMIAL_SIGN: d_monomialSlv.checkSign(); break;
-      case InferStep::NL_RESOLUTION_BOUNDS:
-        d_monomialBoundsSlv.checkResBounds();
-        break;
-      case InferStep::NL_SPLIT_ZERO: d_splitZeroSlv.check(); break;
-      case InferStep::NL_TANGENT_PLANES: d_tangentPlaneSlv.check(false); break;
-      case InferStep::NL_TANGENT_PLANES_WAITING:
-        d_tangentPlaneSlv.check(true);
-        break;
-      case InferStep::TRANS_INIT:
-        d_trSlv.initLastCall(xts);
-        break;
-      case InferStep::TRANS_INITIAL:
-        d_trSlv.checkTranscendentalInitialRefine();
-        break;
-      case InferStep::TRANS_MONOTONIC:
-        d_trSlv.checkTranscendentalMonotonic();
-        break;
-      case InferStep::TRANS_TANGENT_PLANES:
-        d_trSlv.checkTranscendentalTangentPlanes();
+      runStep(step, assertions, false_asserts, xts);
+      if (d_im.hasPendingLemma())
+      {
         break;
+      }
     }
   }
 
@@ -558,6 +506,117 @@ void NonlinearExtension::runStrategy(Theory::Effort effort,
                   << " pending lemmas." << std::endl;
 }
 
+void NonlinearExtension::runSteps(StepGenerator steps,
+                                  const std::vector<Node>& assertions,
+                                  const std::vector<Node>& false_asserts,
+                                  const std::vector<Node>& xts,
+                                  std::vector<InferStep>& skipped)
+{
+  bool allowSkip = options().arith.nlExtLemmaScoring;
+  while (steps.hasNext())
+  {
+    InferStep step = steps.next();
+    if (step == InferStep::BREAK)
+    {
+      if (d_im.hasPendingLemma())
+      {
+        break;
+      }
+      continue;
+    }
+    bool scored = StepScores::isScored(step);
+    if (allowSkip && scored && !d_stepScores.shouldRun(step))
+    {
+      skipped.push_back(step);
+      continue;
+    }
+    std::size_t numLemmas = d_im.numPendingLemmas() + d_im.numWaitingLemmas();
+    std::size_t numDuplicates = d_im.numDuplicateLemmas();
+    std::size_t numConflicts = d_im.numEntailedConflicts();
+    runStep(step, assertions, false_asserts, xts);
+    if (scored)
+    {
+      std::size_t newNumLemmas =
+          d_im.numPendingLemmas() + d_im.numWaitingLemmas();
+      d_stepScores.notify(
+          step,
+          newNumLemmas > numLemmas ? newNumLemmas - numLemmas : 0,
+          d_im.numDuplicateLemmas() - numDuplicates,
+          d_im.numEntailedConflicts() - numConflicts);
+    }
+  }
+}
+
+void NonlinearExtension::runStep(InferStep step,
+                                 const std::vector<Node>& assertions,
+                                 const std::vector<Node>& false_asserts,
+                                 const std::vector<Node>& xts)
+{
+  Trace("nl-strategy") << "Step " << step << std::endl;
+  switch (step)
+  {
+    case InferStep::BREAK: break;
+    case InferStep::FLUSH_WAITING_LEMMAS: d_im.flushWaitingLemmas(); break;
+    case InferStep::CAD_FULL: d_cadSlv.checkFull(); break;
+    case InferStep::CAD_INIT: d_cadSlv.initLastCall(assertions); break;
+    case InferStep::NL_FACTORING:
+      d_factoringSlv.check(assertions, false_asserts);
+      break;
+    case InferStep::IAND_INIT:
+      d_iandSlv.initLastCall(assertions, false_asserts, xts);
+      break;
+    case InferStep::IAND_FULL: d_iandSlv.checkFullRefine(); break;
+    case InferStep::IAND_INITIAL: d_iandSlv.checkInitialRefine(); break;
+    case InferStep::POW2_INIT:
+      d_pow2Slv.initLastCall(assertions, false_asserts, xts);
+      break;
+    case InferStep::POW2_FULL: d_pow2Slv.checkFullRefine(); break;
+    case InferStep::POW2_INITIAL: d_pow2Slv.checkInitialRefine(); break;
+    case InferStep::ICP:
+      d_icpSlv.reset(assertions);
+      d_icpSlv.check();
+      break;
+    case InferStep::NL_INIT:
+      d_extState.init(xts);
+      d_monomialBoundsSlv.init();
+      d_monomialSlv.init(xts);
+      break;
+    case InferStep::NL_MONOMIAL_INFER_BOUNDS:
+      d_monomialBoundsSlv.checkBounds(assertions, false_asserts);
+      break;
+    case InferStep::NL_MONOMIAL_MAGNITUDE0:
+      d_monomialSlv.checkMagnitude(0);
+      break;
+    case InferStep::NL_MONOMIAL_MAGNITUDE1:
+      d_monomialSlv.checkMagnitude(1);
+      break;
+    case InferStep::NL_MONOMIAL_MAGNITUDE2:
+      d_monomialSlv.checkMagnitude(2);
+      break;
+    case InferStep::NL_MONOMIAL_SIGN: d_monomialSlv.checkSign(); break;
+    case InferStep::NL_RESOLUTION_BOUNDS:
+      d_monomialBoundsSlv.checkResBounds();
+      break;
+    case InferStep::NL_SPLIT_ZERO: d_splitZeroSlv.check(); break;
+    case InferStep::NL_TANGENT_PLANES: d_tangentPlaneSlv.check(false); break;
+    case InferStep::NL_TANGENT_PLANES_WAITING:
+      d_tangentPlaneSlv.check(true);
+      break;
+    case InferStep::TRANS_INIT:
+      d_trSlv.initLastCall(xts);
+      break;
+    case InferStep::TRANS_INITIAL:
+      d_trSlv.checkTranscendentalInitialRefine();
+      break;
+    case InferStep::TRANS_MONOTONIC:
+      d_trSlv.checkTranscendentalMonotonic();
+      break;
+    case InferStep::TRANS_TANGENT_PLANES:
+      d_trSlv.checkTranscendentalTangentPlanes();
+      break;
+  }
+}
+
 }  // namespace nl
 }  // namespace arith
 }  // namespace theory
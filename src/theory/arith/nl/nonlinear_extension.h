@@ -36,6 +36,7 @@
 #include "theory/arith/nl/nl_model.h"
 #include "theory/arith/nl/pow2_solver.h"
 #include "theory/arith/nl/stats.h"
+#include "theory/arith/nl/step_scores.h"
 #include "theory/arith/nl/strategy.h"
 #include "theory/arith/nl/transcendental/transcendental_solver.h"
 #include "theory/ext_theory.h"
@@ -198,6 +199,21 @@ class NonlinearExtension : EnvObj
                    const std::vector<Node>& assertions,
                    const std::vector<Node>& false_asserts,
                    const std::vector<Node>& xts);
+  /**
+   * Run the given steps of the strategy, as part of runStrategy(). If lemma
+   * scoring is enabled, steps that are currently considered dominated by
+   * d_stepScores are not run, and are added to skipped instead.
+   */
+  void runSteps(StepGenerator steps,
+                const std::vector<Node>& assertions,
+                const std::vector<Node>& false_asserts,
+                const std::vector<Node>& xts,
+                std::vector<InferStep>& skipped);
+  /** Run a single step of the strategy */
+  void runStep(InferStep step,
+               const std::vector<Node>& assertions,
+               const std::vector<Node>& false_asserts,
+               const std::vector<Node>& xts);
 
   /** commonly used terms */
   Node d_zero;
@@ -272,6 +288,8 @@ class NonlinearExtension : EnvObj
 
   /** The strategy for the nonlinear extension. */
   Strategy d_strategy;
+  /** The usefulness scores of the steps of the strategy. */
+  StepScores d_stepScores;
 
   /**
    * The approximations computed during collectModelInfo. For details, see
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Usefulness scores for the inference steps of the nonlinear extension.
+ */
+
+#include "theory/arith/nl/step_scores.h"
+
+#include <algorithm>
+
+#include "base/output.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+
+StepScores::StepScores(StatisticsRegistry& reg)
+    : d_newLemmas(reg.registerHistogram<InferStep>(
+          "theory::arith::nl::scores::newLemmas")),
+      d_duplicateLemmas(reg.registerHistogram<InferStep>(
+          "theory::arith::nl::scores::duplicateLemmas")),
+      d_conflicts(reg.registerHistogram<InferStep>(
+          "theory::arith::nl::scores::conflicts")),
+      d_skipped(reg.registerHistogram<InferStep>(
+          "theory::arith::nl::scores::skipped"))
+{
+}
+
+bool StepScores::isScored(InferStep step)
+{
+  switch (step)
+  {
+    case InferStep::NL_FACTORING:
+    case InferStep::NL_MONOMIAL_INFER_BOUNDS:
+    case InferStep::NL_MONOMIAL_MAGNITUDE0:
+    case InferStep::NL_MONOMIAL_MAGNITUDE1:
+    case InferStep::NL_MONOMIAL_MAGNITUDE2:
+    case InferStep::NL_MONOMIAL_SIGN:
+    case InferStep::NL_RESOLUTION_BOUNDS:
+    case InferStep::NL_TANGENT_PLANES:
+    case InferStep::NL_TANGENT_PLANES_WAITING:
+    case InferStep::TRANS_MONOTONIC:
+    case InferStep::TRANS_TANGENT_PLANES: return true;
+    default: return false;
+  }
+}
+
+bool StepScores::shouldRun(InferStep step)
+{
+  Score& s = d_scores[step];
+  if (s.d_skip == 0)
+  {
+    return true;
+  }
+  --s.d_skip;
+  d_skipped << step;
+  Trace("nl-strategy") << "Skipping dominated step " << step << std::endl;
+  return false;
+}
+
+void StepScores::notify(InferStep step,
+                        std::size_t numNew,
+                        std::size_t numDuplicate,
+                        std::size_t numConflicts)
+{
+  Trace("nl-strategy") << "Step " << step << " produced " << numNew
+                       << " new lemmas, " << numDuplicate
+                       << " duplicates and " << numConflicts << " conflicts"
+                       << std::endl;
+  for (std::size_t i = 0; i < numNew; ++i)
+  {
+    d_newLemmas << step;
+  }
+  for (std::size_t i = 0; i < numDuplicate; ++i)
+  {
+    d_duplicateLemmas << step;
+  }
+  for (std::size_t i = 0; i < numConflicts; ++i)
+  {
+    d_conflicts << step;
+  }
+  Score& s = d_scores[step];
+  if (numNew > 0 || numConflicts > 0)
+  {
+    s.d_dominated = 0;
+    s.d_skip = 0;
+  }
+  else if (numDuplicate > 0)
+  {
+    // skip the next 1, 2, 4, ... runs of this step
+    s.d_skip = std::size_t(1) << std::min(s.d_dominated, s_maxBackoff);
+    ++s.d_dominated;
+  }
+}
+
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
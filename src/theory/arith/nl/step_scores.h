@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Usefulness scores for the inference steps of the nonlinear extension.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__ARITH__NL__STEP_SCORES_H
+#define CVC5__THEORY__ARITH__NL__STEP_SCORES_H
+
+#include <cstddef>
+#include <map>
+
+#include "theory/arith/nl/strategy.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+
+class StatisticsRegistry;
+
+namespace theory {
+namespace arith {
+namespace nl {
+
+/**
+ * Keeps track of how useful the lemmas produced by the individual lemma
+ * schemas (inference steps) of the nonlinear extension are, and suppresses
+ * the regeneration of lemmas by steps that are dominated by lemmas we already
+ * know.
+ *
+ * After every run of a step, we are notified about the number of new lemmas,
+ * the number of lemmas that were dropped as duplicates, and the number of
+ * lemmas that were entailed to be in conflict. A step whose run only produced
+ * duplicates is considered dominated and is skipped for an exponentially
+ * growing number of subsequent strategy runs. Any new lemma or conflict
+ * resets the backoff of the step.
+ *
+ * Skipping a step may lose lemmas. Hence, if a strategy run skipped some step
+ * and did not produce any lemma, the caller must run the strategy again
+ * without skipping, see NonlinearExtension::runStrategy().
+ *
+ * Steps that produce conflicts are not prioritized, i.e. run earlier than
+ * the strategy says: the strategy orders its steps from cheap to expensive
+ * and some steps rely on the steps before them, so the scores are only used
+ * to suppress dominated steps and as statistics.
+ */
+class StepScores
+{
+ public:
+  StepScores(StatisticsRegistry& reg);
+
+  /** Whether the lemmas produced by the given step are scored. */
+  static bool isScored(InferStep step);
+
+  /**
+   * Whether the given step should be run in the current strategy run. If
+   * this returns false, the step is counted as skipped.
+   */
+  bool shouldRun(InferStep step);
+
+  /**
+   * Notify about the lemmas produced by running the given step.
+   * @param step The step that was run
+   * @param numNew The number of new lemmas
+   * @param numDuplicate The number of lemmas dropped as duplicates
+   * @param numConflicts The number of lemmas entailed to be in conflict
+   */
+  void notify(InferStep step,
+              std::size_t numNew,
+              std::size_t numDuplicate,
+              std::size_t numConflicts);
+
+ private:
+  /** The score of a single step */
+  struct Score
+  {
+    /** The number of consecutive runs that only produced duplicates */
+    std::size_t d_dominated = 0;
+    /** The number of upcoming runs that skip this step */
+    std::size_t d_skip = 0;
+  };
+  /**
+   * The maximal exponent for the backoff, that is a step is skipped for at
+   * most 2^s_maxBackoff consecutive runs.
+   */
+  static constexpr std::size_t s_maxBackoff = 4;
+  /** The scores for all steps */
+  std::map<InferStep, Score> d_scores;
+
+  /** Number of new lemmas per step */
+  HistogramStat<InferStep> d_newLemmas;
+  /** Number of duplicate lemmas per step */
+  HistogramStat<InferStep> d_duplicateLemmas;
+  /** Number of lemmas entailed to be in conflict per step */
+  HistogramStat<InferStep> d_conflicts;
+  /** Number of times a step was skipped */
+  HistogramStat<InferStep> d_skipped;
+};
+
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__ARITH__NL__STEP_SCORES_H */
@@ -15,9 +15,10 @@
 
 #include "theory/arith/nl/transcendental/taylor_generator.h"
 
+#include <mutex>
+
 #include "theory/arith/arith_utilities.h"
 #include "theory/arith/nl/nl_model.h"
-#include "theory/evaluator.h"
 #include "theory/rewriter.h"
 
 using namespace cvc5::kind;
@@ -28,6 +29,38 @@ namespace arith {
 namespace nl {
 namespace transcendental {
 
+namespace {
+
+/**
+ * Appends 1/i! to res for all i with res.size() <= i <= n. The values are
+ * computed on first use and shared between all solver instances, hence the
+ * table is protected by a mutex.
+ */
+void getSharedInverseFactorials(std::uint64_t n, std::vector<Rational>& res)
+{
+  static std::mutex s_mutex;
+  static std::vector<Rational> s_table{Rational(1)};
+  std::lock_guard<std::mutex> guard(s_mutex);
+  while (s_table.size() <= n)
+  {
+    s_table.emplace_back(s_table.back() / Rational(s_table.size()));
+  }
+  res.insert(res.end(), s_table.begin() + res.size(), s_table.begin() + n + 1);
+}
+
+/** Returns x^n */
+Rational power(const Rational& x, std::uint64_t n)
+{
+  Rational res(1);
+  for (std::uint64_t i = 0; i < n; ++i)
+  {
+    res *= x;
+  }
+  return res;
+}
+
+}  // namespace
+
 TaylorGenerator::TaylorGenerator()
     : d_taylor_real_fv(NodeManager::currentNM()->mkBoundVar(
         "x", NodeManager::currentNM()->realType()))
@@ -146,41 +179,18 @@ std::uint64_t TaylorGenerator::getPolynomialApproximationBoundForArg(
   getPolynomialApproximationBounds(k, d, pbounds);
   Trace("nl-trans") << "c = " << c << std::endl;
   Assert(c.isConst());
-  if (k == Kind::EXPONENTIAL && c.getConst<Rational>().sgn() == 1)
-  {
-    bool success = false;
-    std::uint64_t ds = d;
-    TNode ttrf = getTaylorVariable();
-    TNode tc = c;
-    Evaluator eval(nullptr);
-    do
-    {
-      success = true;
-      std::uint64_t n = 2 * ds;
-      std::pair<Node, Node> taylor = getTaylor(k, n);
-      // check that 1-c^{n+1}/(n+1)! > 0
-      Node ru = taylor.second;
-      Node rus = eval.eval(ru, {ttrf}, {tc});
-      Assert(rus.isConst());
-      if (rus.getConst<Rational>() > 1)
-      {
-        success = false;
-        ds = ds + 1;
-      }
-    } while (!success);
-    if (ds > d)
-    {
-      Trace("nl-ext-exp-taylor")
-          << "*** Increase Taylor bound to " << ds << " > " << d << " for ("
-          << k << " " << c << ")" << std::endl;
-      // must use sound upper bound
-      ApproximationBounds pboundss;
-      getPolynomialApproximationBounds(k, ds, pboundss);
-      pbounds.d_upperPos = pboundss.d_upperPos;
-    }
-    return ds;
+  std::uint64_t ds = getSoundDegree(k, c.getConst<Rational>(), d);
+  if (ds > d)
+  {
+    Trace("nl-ext-exp-taylor")
+        << "*** Increase Taylor bound to " << ds << " > " << d << " for (" << k
+        << " " << c << ")" << std::endl;
+    // must use sound upper bound
+    ApproximationBounds pboundss;
+    getPolynomialApproximationBounds(k, ds, pboundss);
+    pbounds.d_upperPos = pboundss.d_upperPos;
   }
-  return d;
+  return ds;
 }
 
 std::pair<Node, Node> TaylorGenerator::getTfModelBounds(Node tf,
@@ -207,37 +217,100 @@ std::pair<Node, Node> TaylorGenerator::getTfModelBounds(Node tf,
   }
   bool isNeg = csign == -1;
 
-  ApproximationBounds pbounds;
-  getPolynomialApproximationBoundForArg(k, c, d, pbounds);
-
-  std::vector<Node> bounds;
-  TNode tfv = getTaylorVariable();
-  TNode tfs = tf[0];
-  Evaluator eval(nullptr);
-  for (unsigned d2 = 0; d2 < 2; d2++)
+  // We evaluate the bounds from getPolynomialApproximationBoundForArg for the
+  // model value of the argument directly on rationals. Notice that we use the
+  // model value of tf[0] as a whole, as
+  // rewrite( x*x { x -> M_A(t) } ) = M_A(t)*M_A(t)
+  // is not equal to
+  // M_A( x*x { x -> t } ) = M_A( t*t )
+  // where M_A denotes the abstract model.
+  const Rational& x = c.getConst<Rational>();
+  std::pair<Rational, Rational> taylor = evaluateTaylor(k, 2 * d, x);
+  Rational lower;
+  Rational upper;
+  if (k == Kind::EXPONENTIAL)
   {
-    Node pab = (d2 == 0 ? pbounds.d_lower
-                        : (isNeg ? pbounds.d_upperNeg : pbounds.d_upperPos));
-    if (!pab.isNull())
+    lower = taylor.first;
+    if (isNeg)
     {
-      // { x -> M_A(tf[0]) }
-      // Notice that we compute the model value of tfs first, so that
-      // the call to rewrite below does not modify the term, where notice that
-      // rewrite( x*x { x -> M_A(t) } ) = M_A(t)*M_A(t)
-      // is not equal to
-      // M_A( x*x { x -> t } ) = M_A( t*t )
-      // where M_A denotes the abstract model.
-      Node mtfs = model.computeAbstractModelValue(tfs);
-      pab = eval.eval(pab, {tfv}, {mtfs});
-      Assert(pab.isConst());
-      bounds.push_back(pab);
+      upper = taylor.first + taylor.second;
     }
     else
     {
-      bounds.push_back(Node::null());
+      std::uint64_t ds = getSoundDegree(k, x, d);
+      if (ds > d)
+      {
+        taylor = evaluateTaylor(k, 2 * ds, x);
+      }
+      upper = taylor.first * (Rational(1) + taylor.second);
     }
   }
-  return std::pair<Node, Node>(bounds[0], bounds[1]);
+  else
+  {
+    Assert(k == Kind::SINE);
+    lower = taylor.first - taylor.second;
+    upper = taylor.first + taylor.second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  return std::pair<Node, Node>(nm->mkConstReal(lower), nm->mkConstReal(upper));
+}
+
+std::pair<Rational, Rational> TaylorGenerator::evaluateTaylor(
+    Kind k, std::uint64_t n, const Rational& x)
+{
+  Assert(n > 0);
+  ensureInverseFactorials(n);
+  // Horner scheme for sum_{i=0}^{n-1} c_i * x^i
+  Rational sum;
+  for (std::uint64_t i = n; i > 0; --i)
+  {
+    sum = sum * x + getCoefficient(k, i - 1);
+  }
+  // x^n / n!
+  return std::make_pair(sum, power(x, n) * d_inverseFactorials[n]);
+}
+
+Rational TaylorGenerator::getCoefficient(Kind k, std::uint64_t i)
+{
+  ensureInverseFactorials(i);
+  if (k == Kind::EXPONENTIAL)
+  {
+    return d_inverseFactorials[i];
+  }
+  Assert(k == Kind::SINE);
+  if (i % 2 == 0)
+  {
+    return Rational(0);
+  }
+  // (-1)^((i-1)/2) / i!
+  return (i % 4 == 1) ? d_inverseFactorials[i] : -d_inverseFactorials[i];
+}
+
+std::uint64_t TaylorGenerator::getSoundDegree(Kind k,
+                                              const Rational& c,
+                                              std::uint64_t d)
+{
+  if (k != Kind::EXPONENTIAL || c.sgn() != 1)
+  {
+    return d;
+  }
+  std::uint64_t ds = d;
+  // check that 1-c^{n+1}/(n+1)! > 0
+  ensureInverseFactorials(2 * ds);
+  while (power(c, 2 * ds) * d_inverseFactorials[2 * ds] > 1)
+  {
+    ds = ds + 1;
+    ensureInverseFactorials(2 * ds);
+  }
+  return ds;
+}
+
+void TaylorGenerator::ensureInverseFactorials(std::uint64_t n)
+{
+  if (d_inverseFactorials.size() <= n)
+  {
+    getSharedInverseFactorials(n, d_inverseFactorials);
+  }
 }
 
 }  // namespace transcendental
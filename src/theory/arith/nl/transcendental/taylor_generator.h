@@ -16,7 +16,10 @@
 #ifndef CVC5__THEORY__ARITH__NL__TRANSCENDENTAL__TAYLOR_GENERATOR_H
 #define CVC5__THEORY__ARITH__NL__TRANSCENDENTAL__TAYLOR_GENERATOR_H
 
+#include <vector>
+
 #include "expr/node.h"
+#include "util/rational.h"
 
 namespace cvc5 {
 namespace theory {
@@ -103,7 +106,31 @@ class TaylorGenerator
                                          std::uint64_t d,
                                          NlModel& model);
 
+  /**
+   * Evaluate the Taylor series of degree n for k at the point x, i.e. return
+   * the values of both parts of the pair returned by getTaylor(k, n) for the
+   * given x. Uses the Horner scheme on rationals instead of constructing and
+   * evaluating nodes.
+   */
+  std::pair<Rational, Rational> evaluateTaylor(Kind k,
+                                               std::uint64_t n,
+                                               const Rational& x);
+
  private:
+  /** Returns the i'th coefficient f^i(0)/i! of the Maclaurin series of k. */
+  Rational getCoefficient(Kind k, std::uint64_t i);
+  /**
+   * Returns the minimal degree ds >= d such that the upper bound for
+   * exponential from getPolynomialApproximationBounds() is sound for c, see
+   * getPolynomialApproximationBoundForArg().
+   */
+  std::uint64_t getSoundDegree(Kind k, const Rational& c, std::uint64_t d);
+  /**
+   * Ensures that d_inverseFactorials contains 1/i! for all i <= n. The values
+   * are copied from a table that is shared by all instances.
+   */
+  void ensureInverseFactorials(std::uint64_t n);
+
   const Node d_taylor_real_fv;
 
   /**
@@ -112,6 +139,8 @@ class TaylorGenerator
    */
   std::map<Kind, std::map<std::uint64_t, std::pair<Node, Node>>> d_taylor_terms;
   std::map<Kind, std::map<std::uint64_t, ApproximationBounds>> d_poly_bounds;
+  /** Stores 1/i! at index i */
+  std::vector<Rational> d_inverseFactorials;
 };
 
 }  // namespace transcendental
@@ -63,6 +63,11 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
   Assert(!isBasic(oldBasic));
   Assert(isBasic(newBasic));
   Assert(getColLength(newBasic) == 1);
+
+  if (shouldCompactEntries())
+  {
+    compactEntries();
+  }
 }
 
 /**
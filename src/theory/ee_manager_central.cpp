@@ -15,6 +15,7 @@
 
 #include "theory/ee_manager_central.h"
 
+#include "options/quantifiers_options.h"
 #include "smt/env.h"
 #include "theory/quantifiers_engine.h"
 #include "theory/shared_solver.h"
@@ -122,6 +123,10 @@ void EqEngineManagerCentral::initializeTheories()
           << std::endl;
       d_masterEqualityEngine = &d_centralEqualityEngine;
       d_centralEENotify.d_newClassNotify.push_back(d_masterEENotify.get());
+      if (options().quantifiers.eMatchingInc)
+      {
+        d_centralEENotify.d_mergeNotify.push_back(d_masterEENotify.get());
+      }
     }
   }
 
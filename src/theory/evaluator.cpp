@@ -123,6 +123,28 @@ Node EvalResult::toNode() const
   }
 }
 
+namespace {
+
+/**
+ * Get the result for value v, which is invalid if v is not a constant that
+ * is supported by EvalResult.
+ */
+EvalResult toEvalResult(TNode v)
+{
+  switch (v.getKind())
+  {
+    case kind::CONST_BOOLEAN: return EvalResult(v.getConst<bool>());
+    case kind::CONST_RATIONAL: return EvalResult(v.getConst<Rational>());
+    case kind::CONST_STRING: return EvalResult(v.getConst<String>());
+    case kind::CONST_BITVECTOR: return EvalResult(v.getConst<BitVector>());
+    case kind::UNINTERPRETED_SORT_VALUE:
+      return EvalResult(v.getConst<UninterpretedSortValue>());
+    default: return EvalResult();
+  }
+}
+
+}  // namespace
+
 Evaluator::Evaluator(Rewriter* rr, uint32_t alphaCard)
     : d_rr(rr), d_alphaCard(alphaCard)
 {
@@ -375,34 +397,6 @@ EvalResult Evaluator::evalInternal(
           results[currNode] = EvalResult(currNodeVal.getConst<bool>());
           break;
 
-        case kind::NOT:
-        {
-          results[currNode] = EvalResult(!(results[currNode[0]].d_bool));
-          break;
-        }
-
-        case kind::AND:
-        {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res && results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::OR:
-        {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res || results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
         case kind::CONST_RATIONAL:
         {
           const Rational& r = currNodeVal.getConst<Rational>();
@@ -416,497 +410,538 @@ EvalResult Evaluator::evalInternal(
           results[currNode] = EvalResult(av);
           break;
         }
-        case kind::PLUS:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
+        case kind::CONST_STRING:
+          results[currNode] = EvalResult(currNodeVal.getConst<String>());
           break;
-        }
 
-        case kind::MINUS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x - y);
+        case kind::CONST_BITVECTOR:
+          results[currNode] = EvalResult(currNodeVal.getConst<BitVector>());
           break;
-        }
 
-        case kind::UMINUS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(-x);
-          break;
-        }
-        case kind::MULT:
-        case kind::NONLINEAR_MULT:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::DIVISION:
-        case kind::DIVISION_TOTAL:
+        default:
         {
-          Rational res = results[currNode[0]].d_rat;
-          bool divbyzero = false;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+          // evaluate the operator of currNodeVal, whose children have valid
+          // results if it has any
+          std::vector<const EvalResult*> cres;
+          for (TNode cn : currNodeVal)
           {
-            if (results[currNode[i]].d_rat.isZero())
-            {
-              Trace("evaluator")
-                  << "Division by zero not supported" << std::endl;
-              divbyzero = true;
-              results[currNode] = EvalResult();
-              break;
-            }
-            res = res / results[currNode[i]].d_rat;
+            cres.push_back(&results[cn]);
           }
-          if (divbyzero)
+          EvalResult res = evalOp(currNodeVal, cres);
+          if (res.d_tag == EvalResult::INVALID)
           {
             processUnhandled(
                 currNode, currNodeVal, evalAsNode, results, needsReconstruct);
           }
           else
           {
-            results[currNode] = EvalResult(res);
+            results[currNode] = res;
           }
-          break;
         }
+      }
+    }
+  }
 
-        case kind::GEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x >= y);
-          break;
-        }
-        case kind::LEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x <= y);
-          break;
-        }
-        case kind::GT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x > y);
-          break;
-        }
-        case kind::LT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x < y);
-          break;
-        }
-        case kind::ABS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x.abs());
-          break;
-        }
-        case kind::CAST_TO_REAL:
-        {
-          // casting to real is a no-op
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x);
-          break;
-        }
-        case kind::CONST_STRING:
-          results[currNode] = EvalResult(currNodeVal.getConst<String>());
-          break;
+  return results[n];
+}
 
-        case kind::STRING_CONCAT:
-        {
-          String res = results[currNode[0]].d_str;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_str);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+EvalResult Evaluator::evalOp(TNode n,
+                             const std::vector<const EvalResult*>& cres) const
+{
+  EvalResult ret;
+  switch (n.getKind())
+  {
+    case kind::NOT:
+    {
+      ret = EvalResult(!(cres[0]->d_bool));
+      break;
+    }
 
-        case kind::STRING_LENGTH:
-        {
-          const String& s = results[currNode[0]].d_str;
-          results[currNode] = EvalResult(Rational(s.size()));
-          break;
-        }
+    case kind::AND:
+    {
+      bool res = cres[0]->d_bool;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res && cres[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_SUBSTR:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          Integer j = results[currNode[2]].d_rat.getNumerator();
+    case kind::OR:
+    {
+      bool res = cres[0]->d_bool;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res || cres[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-          if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else if (i + j > s_len)
-          {
-            results[currNode] =
-                EvalResult(s.suffix((s_len - i).toUnsignedInt()));
-          }
-          else
-          {
-            results[currNode] =
-                EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
-          }
-          break;
-        }
+    case kind::PLUS:
+    {
+      Rational res = cres[0]->d_rat;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res + cres[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_UPDATE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          const String& t = results[currNode[2]].d_str;
+    case kind::MINUS:
+    {
+      const Rational& x = cres[0]->d_rat;
+      const Rational& y = cres[1]->d_rat;
+      ret = EvalResult(x - y);
+      break;
+    }
 
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(s);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.update(i.toUnsignedInt(), t));
-          }
-          break;
-        }
-        case kind::STRING_CHARAT:
+    case kind::UMINUS:
+    {
+      const Rational& x = cres[0]->d_rat;
+      ret = EvalResult(-x);
+      break;
+    }
+    case kind::MULT:
+    case kind::NONLINEAR_MULT:
+    {
+      Rational res = cres[0]->d_rat;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res * cres[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::DIVISION:
+    case kind::DIVISION_TOTAL:
+    {
+      Rational res = cres[0]->d_rat;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        if (cres[i]->d_rat.isZero())
         {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.substr(i.toUnsignedInt(), 1));
-          }
-          break;
+          Trace("evaluator") << "Division by zero not supported" << std::endl;
+          return EvalResult();
         }
+        res = res / cres[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_CONTAINS:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& t = results[currNode[1]].d_str;
-          results[currNode] = EvalResult(s.find(t) != std::string::npos);
-          break;
-        }
+    case kind::GEQ:
+    {
+      const Rational& x = cres[0]->d_rat;
+      const Rational& y = cres[1]->d_rat;
+      ret = EvalResult(x >= y);
+      break;
+    }
+    case kind::LEQ:
+    {
+      const Rational& x = cres[0]->d_rat;
+      const Rational& y = cres[1]->d_rat;
+      ret = EvalResult(x <= y);
+      break;
+    }
+    case kind::GT:
+    {
+      const Rational& x = cres[0]->d_rat;
+      const Rational& y = cres[1]->d_rat;
+      ret = EvalResult(x > y);
+      break;
+    }
+    case kind::LT:
+    {
+      const Rational& x = cres[0]->d_rat;
+      const Rational& y = cres[1]->d_rat;
+      ret = EvalResult(x < y);
+      break;
+    }
+    case kind::ABS:
+    {
+      const Rational& x = cres[0]->d_rat;
+      ret = EvalResult(x.abs());
+      break;
+    }
+    case kind::CAST_TO_REAL:
+    {
+      // casting to real is a no-op
+      const Rational& x = cres[0]->d_rat;
+      ret = EvalResult(x);
+      break;
+    }
+    case kind::STRING_CONCAT:
+    {
+      String res = cres[0]->d_str;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(cres[i]->d_str);
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_INDEXOF:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          const String& x = results[currNode[1]].d_str;
-          Integer i = results[currNode[2]].d_rat.getNumerator();
+    case kind::STRING_LENGTH:
+    {
+      const String& s = cres[0]->d_str;
+      ret = EvalResult(Rational(s.size()));
+      break;
+    }
 
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          else
-          {
-            size_t r = s.find(x, i.toUnsignedInt());
-            if (r == std::string::npos)
-            {
-              results[currNode] = EvalResult(Rational(-1));
-            }
-            else
-            {
-              results[currNode] = EvalResult(Rational(r));
-            }
-          }
-          break;
-        }
+    case kind::STRING_SUBSTR:
+    {
+      const String& s = cres[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = cres[1]->d_rat.getNumerator();
+      Integer j = cres[2]->d_rat.getNumerator();
 
-        case kind::STRING_REPLACE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& x = results[currNode[1]].d_str;
-          const String& y = results[currNode[2]].d_str;
-          results[currNode] = EvalResult(s.replace(x, y));
-          break;
-        }
+      if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(String(""));
+      }
+      else if (i + j > s_len)
+      {
+        ret =
+            EvalResult(s.suffix((s_len - i).toUnsignedInt()));
+      }
+      else
+      {
+        ret =
+            EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
+      }
+      break;
+    }
 
-        case kind::STRING_PREFIX:
-        {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.prefix(t.size()) == t);
-          }
-          break;
-        }
+    case kind::STRING_UPDATE:
+    {
+      const String& s = cres[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = cres[1]->d_rat.getNumerator();
+      const String& t = cres[2]->d_str;
 
-        case kind::STRING_SUFFIX:
-        {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.suffix(t.size()) == t);
-          }
-          break;
-        }
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(s);
+      }
+      else
+      {
+        ret = EvalResult(s.update(i.toUnsignedInt(), t));
+      }
+      break;
+    }
+    case kind::STRING_CHARAT:
+    {
+      const String& s = cres[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = cres[1]->d_rat.getNumerator();
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(String(""));
+      }
+      else
+      {
+        ret = EvalResult(s.substr(i.toUnsignedInt(), 1));
+      }
+      break;
+    }
 
-        case kind::STRING_ITOS:
-        {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(i.toString()));
-          }
-          break;
-        }
+    case kind::STRING_CONTAINS:
+    {
+      const String& s = cres[0]->d_str;
+      const String& t = cres[1]->d_str;
+      ret = EvalResult(s.find(t) != std::string::npos);
+      break;
+    }
 
-        case kind::STRING_STOI:
-        {
-          const String& s = results[currNode[0]].d_str;
-          if (s.isNumber())
-          {
-            results[currNode] = EvalResult(Rational(s.toNumber()));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
-        }
+    case kind::STRING_INDEXOF:
+    {
+      const String& s = cres[0]->d_str;
+      Integer s_len(s.size());
+      const String& x = cres[1]->d_str;
+      Integer i = cres[2]->d_rat.getNumerator();
 
-        case kind::STRING_FROM_CODE:
+      if (i.strictlyNegative())
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      else
+      {
+        size_t r = s.find(x, i.toUnsignedInt());
+        if (r == std::string::npos)
         {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i >= 0 && i < d_alphaCard)
-          {
-            std::vector<unsigned> svec = {i.toUnsignedInt()};
-            results[currNode] = EvalResult(String(svec));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          break;
+          ret = EvalResult(Rational(-1));
         }
-
-        case kind::STRING_TO_CODE:
+        else
         {
-          const String& s = results[currNode[0]].d_str;
-          if (s.size() == 1)
-          {
-            results[currNode] = EvalResult(Rational(s.getVec()[0]));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
+          ret = EvalResult(Rational(r));
         }
+      }
+      break;
+    }
 
-        case kind::CONST_BITVECTOR:
-          results[currNode] = EvalResult(currNodeVal.getConst<BitVector>());
-          break;
+    case kind::STRING_REPLACE:
+    {
+      const String& s = cres[0]->d_str;
+      const String& x = cres[1]->d_str;
+      const String& y = cres[2]->d_str;
+      ret = EvalResult(s.replace(x, y));
+      break;
+    }
 
-        case kind::BITVECTOR_NOT:
-          results[currNode] = EvalResult(~results[currNode[0]].d_bv);
-          break;
+    case kind::STRING_PREFIX:
+    {
+      const String& t = cres[0]->d_str;
+      const String& s = cres[1]->d_str;
+      if (s.size() < t.size())
+      {
+        ret = EvalResult(false);
+      }
+      else
+      {
+        ret = EvalResult(s.prefix(t.size()) == t);
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_NEG:
-          results[currNode] = EvalResult(-results[currNode[0]].d_bv);
-          break;
+    case kind::STRING_SUFFIX:
+    {
+      const String& t = cres[0]->d_str;
+      const String& s = cres[1]->d_str;
+      if (s.size() < t.size())
+      {
+        ret = EvalResult(false);
+      }
+      else
+      {
+        ret = EvalResult(s.suffix(t.size()) == t);
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_EXTRACT:
-        {
-          unsigned lo = bv::utils::getExtractLow(currNodeVal);
-          unsigned hi = bv::utils::getExtractHigh(currNodeVal);
-          results[currNode] =
-              EvalResult(results[currNode[0]].d_bv.extract(hi, lo));
-          break;
-        }
+    case kind::STRING_ITOS:
+    {
+      Integer i = cres[0]->d_rat.getNumerator();
+      if (i.strictlyNegative())
+      {
+        ret = EvalResult(String(""));
+      }
+      else
+      {
+        ret = EvalResult(String(i.toString()));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_CONCAT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_bv);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::STRING_STOI:
+    {
+      const String& s = cres[0]->d_str;
+      if (s.isNumber())
+      {
+        ret = EvalResult(Rational(s.toNumber()));
+      }
+      else
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_ADD:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::STRING_FROM_CODE:
+    {
+      Integer i = cres[0]->d_rat.getNumerator();
+      if (i >= 0 && i < d_alphaCard)
+      {
+        std::vector<unsigned> svec = {i.toUnsignedInt()};
+        ret = EvalResult(String(svec));
+      }
+      else
+      {
+        ret = EvalResult(String(""));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_MULT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_AND:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res & results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::STRING_TO_CODE:
+    {
+      const String& s = cres[0]->d_str;
+      if (s.size() == 1)
+      {
+        ret = EvalResult(Rational(s.getVec()[0]));
+      }
+      else
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_OR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res | results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::BITVECTOR_NOT:
+      ret = EvalResult(~cres[0]->d_bv);
+      break;
+
+    case kind::BITVECTOR_NEG:
+      ret = EvalResult(-cres[0]->d_bv);
+      break;
+
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned lo = bv::utils::getExtractLow(n);
+      unsigned hi = bv::utils::getExtractHigh(n);
+      ret =
+          EvalResult(cres[0]->d_bv.extract(hi, lo));
+      break;
+    }
+
+    case kind::BITVECTOR_CONCAT:
+    {
+      BitVector res = cres[0]->d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(cres[i]->d_bv);
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_ADD:
+    {
+      BitVector res = cres[0]->d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res + cres[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_MULT:
+    {
+      BitVector res = cres[0]->d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res * cres[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_AND:
+    {
+      BitVector res = cres[0]->d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res & cres[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_OR:
+    {
+      BitVector res = cres[0]->d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res | cres[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_XOR:
+    {
+      BitVector res = cres[0]->d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res ^ cres[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_UDIV:
+    {
+      BitVector res = cres[0]->d_bv;
+      res = res.unsignedDivTotal(cres[1]->d_bv);
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_UREM:
+    {
+      BitVector res = cres[0]->d_bv;
+      res = res.unsignedRemTotal(cres[1]->d_bv);
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::EQUAL:
+    {
+      EvalResult lhs = *cres[0];
+      EvalResult rhs = *cres[1];
+
+      switch (lhs.d_tag)
+      {
+        case EvalResult::BOOL:
         {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res ^ results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
+          ret = EvalResult(lhs.d_bool == rhs.d_bool);
           break;
         }
-        case kind::BITVECTOR_UDIV:
+
+        case EvalResult::BITVECTOR:
         {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.unsignedDivTotal(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
+          ret = EvalResult(lhs.d_bv == rhs.d_bv);
           break;
         }
-        case kind::BITVECTOR_UREM:
+
+        case EvalResult::RATIONAL:
         {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.unsignedRemTotal(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
+          ret = EvalResult(lhs.d_rat == rhs.d_rat);
           break;
         }
 
-        case kind::EQUAL:
+        case EvalResult::STRING:
         {
-          EvalResult lhs = results[currNode[0]];
-          EvalResult rhs = results[currNode[1]];
-
-          switch (lhs.d_tag)
-          {
-            case EvalResult::BOOL:
-            {
-              results[currNode] = EvalResult(lhs.d_bool == rhs.d_bool);
-              break;
-            }
-
-            case EvalResult::BITVECTOR:
-            {
-              results[currNode] = EvalResult(lhs.d_bv == rhs.d_bv);
-              break;
-            }
-
-            case EvalResult::RATIONAL:
-            {
-              results[currNode] = EvalResult(lhs.d_rat == rhs.d_rat);
-              break;
-            }
-
-            case EvalResult::STRING:
-            {
-              results[currNode] = EvalResult(lhs.d_str == rhs.d_str);
-              break;
-            }
-            case EvalResult::UVALUE:
-            {
-              results[currNode] = EvalResult(lhs.d_av == rhs.d_av);
-              break;
-            }
-
-            default:
-            {
-              Trace("evaluator") << "Theory " << Theory::theoryOf(currNode[0])
-                                 << " not supported" << std::endl;
-              results[currNode] = EvalResult();
-              evalAsNode[currNode] =
-                  needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                                   : currNodeVal;
-              break;
-            }
-          }
-
+          ret = EvalResult(lhs.d_str == rhs.d_str);
           break;
         }
-
-        case kind::ITE:
+        case EvalResult::UVALUE:
         {
-          if (results[currNode[0]].d_bool)
-          {
-            results[currNode] = results[currNode[1]];
-          }
-          else
-          {
-            results[currNode] = results[currNode[2]];
-          }
+          ret = EvalResult(lhs.d_av == rhs.d_av);
           break;
         }
 
         default:
         {
-          Trace("evaluator") << "Kind " << currNodeVal.getKind()
+          Trace("evaluator") << "Theory " << Theory::theoryOf(n[0])
                              << " not supported" << std::endl;
-          processUnhandled(
-              currNode, currNodeVal, evalAsNode, results, needsReconstruct);
+          break;
         }
       }
+
+      break;
     }
-  }
 
-  return results[n];
+    case kind::ITE:
+    {
+      if (cres[0]->d_bool)
+      {
+        ret = *cres[1];
+      }
+      else
+      {
+        ret = *cres[2];
+      }
+      break;
+    }
+
+    default:
+    {
+      Trace("evaluator") << "Kind " << n.getKind() << " not supported"
+                         << std::endl;
+      break;
+    }
+  }
+  return ret;
 }
 
 Node Evaluator::reconstruct(TNode n,
@@ -983,5 +1018,138 @@ void Evaluator::processUnhandled(TNode n,
   evalAsNode[n] = needsReconstruct ? reconstruct(n, results, evalAsNode) : Node(nv);
 }
 
+EvaluatorProgram::EvaluatorProgram(const Evaluator& eval,
+                                   TNode n,
+                                   const std::vector<Node>& args)
+    : d_eval(eval), d_term(n), d_args(args), d_compiled(true)
+{
+  // map from subterms to the register of their instruction
+  std::unordered_map<TNode, size_t> regs;
+  std::unordered_map<TNode, bool> visited;
+  std::unordered_map<TNode, bool>::iterator it;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(d_term);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    it = visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = false;
+      visit.push_back(cur);
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    if (it->second)
+    {
+      continue;
+    }
+    it->second = true;
+    Instruction ins;
+    ins.d_node = cur;
+    ins.d_var = s_noVar;
+    EvalResult cres;
+    std::vector<Node>::const_iterator itv =
+        std::find(d_args.begin(), d_args.end(), cur);
+    if (itv != d_args.end())
+    {
+      ins.d_var = std::distance(d_args.cbegin(), itv);
+    }
+    else if (cur.getNumChildren() == 0)
+    {
+      cres = toEvalResult(cur);
+    }
+    else if (cur.getMetaKind() != kind::metakind::PARAMETERIZED
+             || cur.getOperator().isConst())
+    {
+      // since values of variables are not known yet, children of instructions
+      // that depend on them have an invalid result here
+      std::vector<const EvalResult*> ccres;
+      bool isConst = true;
+      for (TNode cn : cur)
+      {
+        Assert(regs.find(cn) != regs.end());
+        size_t r = regs[cn];
+        ins.d_children.push_back(r);
+        ccres.push_back(&d_consts[r]);
+        isConst = isConst && d_consts[r].d_tag != EvalResult::INVALID;
+      }
+      if (!isConst)
+      {
+        regs[cur] = d_instrs.size();
+        d_instrs.push_back(ins);
+        d_consts.emplace_back();
+        continue;
+      }
+      cres = d_eval.evalOp(cur, ccres);
+    }
+    if (ins.d_var == s_noVar && cres.d_tag == EvalResult::INVALID)
+    {
+      // a subterm that does not depend on the variables cannot be evaluated,
+      // e.g. an application of a function
+      Trace("evaluator") << "EvaluatorProgram: cannot compile " << cur
+                         << std::endl;
+      d_compiled = false;
+      break;
+    }
+    regs[cur] = d_instrs.size();
+    d_instrs.push_back(ins);
+    d_consts.push_back(cres);
+  } while (!visit.empty());
+  if (!d_compiled)
+  {
+    d_instrs.clear();
+    d_consts.clear();
+  }
+  Trace("evaluator") << "EvaluatorProgram: compiled " << n << " into "
+                     << d_instrs.size() << " instructions" << std::endl;
+}
+
+Node EvaluatorProgram::eval(const std::vector<Node>& vals) const
+{
+  Assert(vals.size() == d_args.size());
+  if (!d_compiled)
+  {
+    return d_eval.eval(d_term, d_args, vals);
+  }
+  std::vector<EvalResult> regs(d_instrs.size());
+  std::vector<const EvalResult*> cres;
+  for (size_t i = 0, ninstrs = d_instrs.size(); i < ninstrs; i++)
+  {
+    if (d_consts[i].d_tag != EvalResult::INVALID)
+    {
+      continue;
+    }
+    const Instruction& ins = d_instrs[i];
+    if (ins.d_var != s_noVar)
+    {
+      regs[i] = toEvalResult(vals[ins.d_var]);
+    }
+    else
+    {
+      cres.clear();
+      for (size_t c : ins.d_children)
+      {
+        cres.push_back(d_consts[c].d_tag != EvalResult::INVALID ? &d_consts[c]
+                                                                 : &regs[c]);
+      }
+      regs[i] = d_eval.evalOp(ins.d_node, cres);
+    }
+    if (regs[i].d_tag == EvalResult::INVALID)
+    {
+      // e.g. a value that is not constant or a division by zero
+      Trace("evaluator") << "EvaluatorProgram: fall back at " << ins.d_node
+                         << std::endl;
+      return d_eval.eval(d_term, d_args, vals);
+    }
+  }
+  const EvalResult& ret = d_consts.back().d_tag != EvalResult::INVALID
+                              ? d_consts.back()
+                              : regs.back();
+  return ret.toNode();
+}
+
 }  // namespace theory
 }  // namespace cvc5
@@ -84,11 +84,14 @@ class Rewriter;
 
 /**
  * The class that performs the actual evaluation of a term under a
- * substitution. Right now, the class does not cache anything between different
- * calls to `eval` but this might change in the future.
+ * substitution. This class does not cache anything between different calls to
+ * `eval`. A term that is evaluated under many substitutions can be compiled
+ * into an EvaluatorProgram instead.
  */
 class Evaluator
 {
+  friend class EvaluatorProgram;
+
  public:
   /**
    * @param rr (optional) the rewriter to use when a node cannot be evaluated.
@@ -170,12 +173,85 @@ class Evaluator
                         std::unordered_map<TNode, Node>& evalAsNode,
                         std::unordered_map<TNode, EvalResult>& results,
                         bool needsReconstruct) const;
+  /**
+   * Evaluate the application n of an operator whose children have the
+   * (valid) results cres. Returns an invalid EvalResult if the operator is
+   * not supported or cannot be evaluated on these arguments, e.g. division by
+   * zero.
+   */
+  EvalResult evalOp(TNode n, const std::vector<const EvalResult*>& cres) const;
   /** The (optional) rewriter to be used */
   Rewriter* d_rr;
   /** The cardinality of the alphabet of strings */
   uint32_t d_alphaCard;
 };
 
+/**
+ * A term compiled for repeated evaluation under substitutions of a fixed list
+ * of variables.
+ *
+ * The term is linearized once into a sequence of instructions in post-order,
+ * one for each subterm, where each instruction writes its result to a
+ * register and reads the results of its children from the registers of
+ * earlier instructions. Subterms that do not contain the variables are
+ * evaluated when compiling. Evaluating the program is a single pass over the
+ * instructions, without the lookups in hash maps and the traversal of the
+ * Evaluator.
+ *
+ * If the term contains subterms that cannot be compiled (e.g. applications of
+ * uninterpreted functions or lambdas), or an instruction or value of a
+ * variable cannot be evaluated, we fall back to Evaluator::eval.
+ */
+class EvaluatorProgram
+{
+ public:
+  /**
+   * Compile n for substitutions of args, where eval is used for evaluating
+   * the operators and as the fallback.
+   */
+  EvaluatorProgram(const Evaluator& eval,
+                   TNode n,
+                   const std::vector<Node>& args);
+  /** Get the term of this program */
+  Node getTerm() const { return d_term; }
+  /** Is the term of this program compiled (not only evaluated by fallback)? */
+  bool isCompiled() const { return d_compiled; }
+  /**
+   * Evaluate the term of this program under the substitution of its
+   * variables by vals, returns the same as Evaluator::eval.
+   */
+  Node eval(const std::vector<Node>& vals) const;
+
+ private:
+  /** An instruction of the program */
+  struct Instruction
+  {
+    /** The subterm computed by this instruction */
+    TNode d_node;
+    /** The index of the variable, if this instruction loads a variable */
+    size_t d_var;
+    /** The registers of the children */
+    std::vector<size_t> d_children;
+  };
+  /** The value of an index that is not a variable */
+  static constexpr size_t s_noVar = static_cast<size_t>(-1);
+  /** The evaluator */
+  const Evaluator& d_eval;
+  /** The term */
+  Node d_term;
+  /** The variables */
+  std::vector<Node> d_args;
+  /** Whether d_term was compiled */
+  bool d_compiled;
+  /** The instructions, the last one computes d_term */
+  std::vector<Instruction> d_instrs;
+  /**
+   * The results of the instructions that are computed when compiling, which
+   * are invalid for instructions that depend on the variables.
+   */
+  std::vector<EvalResult> d_consts;
+};
+
 }  // namespace theory
 }  // namespace cvc5
 
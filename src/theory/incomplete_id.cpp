@@ -37,6 +37,8 @@ const char* toString(IncompleteId i)
       return "QUANTIFIERS_MAX_INST_ROUNDS";
     case IncompleteId::QUANTIFIERS_SYGUS_SOLVED:
       return "QUANTIFIERS_SYGUS_SOLVED";
+    case IncompleteId::QUANTIFIERS_SYGUS_SHARD:
+      return "QUANTIFIERS_SYGUS_SHARD";
     case IncompleteId::SEP: return "SEP";
     case IncompleteId::SETS_RELS_CARD: return "SETS_RELS_CARD";
     case IncompleteId::STRINGS_LOOP_SKIP: return "STRINGS_LOOP_SKIP";
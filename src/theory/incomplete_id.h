@@ -47,6 +47,9 @@ enum class IncompleteId
   // we solved a negated synthesis conjecture and will terminate as a subsolver
   // with unknown
   QUANTIFIERS_SYGUS_SOLVED,
+  // we exhausted the values of one shard of a sygus enumerator, which does
+  // not imply that the conjecture is infeasible
+  QUANTIFIERS_SYGUS_SHARD,
   // incomplete due to separation logic
   SEP,
   // relations were used in combination with set cardinality constraints
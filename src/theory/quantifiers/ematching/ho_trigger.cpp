@@ -376,7 +376,7 @@ bool HigherOrderTrigger::sendInstantiation(std::vector<Node>& m, InferenceId id)
   else
   {
     // do not run higher-order matching
-    return d_qim.getInstantiate()->addInstantiation(d_quant, m, id);
+    return Trigger::sendInstantiation(m, id);
   }
 }
 
@@ -389,7 +389,8 @@ bool HigherOrderTrigger::sendInstantiation(std::vector<Node>& m,
                           << d_ho_var_list.size() << std::endl;
   if (var_index == d_ho_var_list.size())
   {
-    // we now have an instantiation to try
+    // We now have an instantiation to try. This is not batched, since we
+    // stop trying alternatives once an instantiation is added.
     return d_qim.getInstantiate()->addInstantiation(
         d_quant, m, InferenceId::QUANTIFIERS_INST_E_MATCHING_HO);
   }
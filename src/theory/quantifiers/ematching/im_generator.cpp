@@ -16,6 +16,8 @@
 #include "theory/quantifiers/ematching/im_generator.h"
 
 #include "theory/quantifiers/ematching/trigger.h"
+#include "theory/quantifiers/instantiate.h"
+#include "theory/quantifiers/quantifiers_inference_manager.h"
 
 using namespace cvc5::kind;
 
@@ -34,6 +36,18 @@ bool IMGenerator::sendInstantiation(InstMatch& m, InferenceId id)
   return d_tparent->sendInstantiation(m, id);
 }
 
+bool IMGenerator::hasInstantiation(InstMatch& m)
+{
+  Instantiate* ie = d_tparent->d_qim.getInstantiate();
+  return !ie->isBatching()
+         && ie->existsInstantiation(d_tparent->d_quant, m.d_vals);
+}
+
+context::Context* IMGenerator::getSatContext() const
+{
+  return d_tparent->context();
+}
+
 }  // namespace inst
 }  // namespace quantifiers
 }  // namespace theory
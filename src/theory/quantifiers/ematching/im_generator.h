@@ -19,6 +19,7 @@
 #define CVC5__THEORY__QUANTIFIERS__IM_GENERATOR_H
 
 #include <map>
+#include "context/context.h"
 #include "expr/node.h"
 #include "theory/inference_id.h"
 #include "theory/quantifiers/inst_match.h"
@@ -107,6 +108,15 @@ protected:
   * lemma cache.
   */
  bool sendInstantiation(InstMatch& m, InferenceId id);
+ /**
+  * Returns true if the instantiation specified by m is known to have been
+  * added, e.g. by an earlier call to sendInstantiation(...). This returns
+  * false if candidates are batched (see Instantiate::isBatching), since they
+  * may still be rejected when the batch is processed.
+  */
+ bool hasInstantiation(InstMatch& m);
+ /** Get the SAT context */
+ context::Context* getSatContext() const;
  /** The parent trigger that owns this */
  Trigger* d_tparent;
  /** Reference to the state of the quantifiers engine */
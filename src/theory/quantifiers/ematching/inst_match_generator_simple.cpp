@@ -15,6 +15,7 @@
 #include "theory/quantifiers/ematching/inst_match_generator_simple.h"
 
 #include "options/quantifiers_options.h"
+#include "theory/quantifiers/ematching/match_code_tree.h"
 #include "theory/quantifiers/ematching/trigger_term_info.h"
 #include "theory/quantifiers/instantiate.h"
 #include "theory/quantifiers/quantifiers_state.h"
@@ -31,8 +32,14 @@ namespace inst {
 
 InstMatchGeneratorSimple::InstMatchGeneratorSimple(Trigger* tparent,
                                                    Node q,
-                                                   Node pat)
-    : IMGenerator(tparent), d_quant(q), d_match_pattern(pat)
+                                                   Node pat,
+                                                   MatchCodeTree* mct)
+    : IMGenerator(tparent),
+      d_quant(q),
+      d_match_pattern(pat),
+      d_codeTree(nullptr),
+      d_patternId(0),
+      d_lastCompleteRound(getSatContext(), 0)
 {
   if (d_match_pattern.getKind() == NOT)
   {
@@ -68,12 +75,69 @@ InstMatchGeneratorSimple::InstMatchGeneratorSimple(Trigger* tparent,
   }
   TermDb* tdb = d_treg.getTermDatabase();
   d_op = tdb->getMatchOperator(d_match_pattern);
+  // the code tree does not handle polarity information
+  if (mct != nullptr && d_eqc.isNull())
+  {
+    d_codeTree = mct;
+    d_patternId = mct->addPattern(q, d_match_pattern);
+  }
 }
 
 void InstMatchGeneratorSimple::resetInstantiationRound() {}
 uint64_t InstMatchGeneratorSimple::addInstantiations(Node q)
 {
   uint64_t addedLemmas = 0;
+  if (d_codeTree != nullptr)
+  {
+    if (d_qstate.isInConflict())
+    {
+      return addedLemmas;
+    }
+    // matches that were not modified since the last round in which we
+    // processed all matches were already considered
+    bool isInc = options::eMatchingInc();
+    uint64_t minRound = isInc ? d_lastCompleteRound.get() : 0;
+    // whether all matches led to instantiations that are known to be added
+    bool complete = true;
+    InstMatch m(q);
+    std::vector<MatchCodeTree::Match> matches =
+        d_codeTree->getMatches(d_patternId);
+    for (const MatchCodeTree::Match& mt : matches)
+    {
+      if (mt.d_modifiedRound < minRound)
+      {
+        continue;
+      }
+      const Node& t = mt.d_term;
+      Debug("simple-trigger") << "Actual term is " << t << std::endl;
+      for (const auto& v : d_var_num)
+      {
+        if (v.second >= 0)
+        {
+          Assert(v.first < t.getNumChildren());
+          m.setValue(v.second, t[v.first]);
+        }
+      }
+      if (sendInstantiation(m, InferenceId::QUANTIFIERS_INST_E_MATCHING_SIMPLE))
+      {
+        addedLemmas++;
+        Debug("simple-trigger")
+            << "-> Produced instantiation " << m << std::endl;
+      }
+      // instantiations that were rejected, e.g. since they were entailed in
+      // the current context, must be retried in later rounds
+      complete = complete && (!isInc || hasInstantiation(m));
+      if (d_qstate.isInConflict())
+      {
+        return addedLemmas;
+      }
+    }
+    if (complete)
+    {
+      d_lastCompleteRound = d_treg.getTermDatabase()->getRound();
+    }
+    return addedLemmas;
+  }
   TNodeTrie* tat;
   TermDb* tdb = d_treg.getTermDatabase();
   if (d_eqc.isNull())
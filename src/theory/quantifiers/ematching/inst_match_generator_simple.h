@@ -21,6 +21,7 @@
 #include <map>
 #include <vector>
 
+#include "context/cdo.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/ematching/inst_match_generator.h"
 
@@ -29,6 +30,8 @@ namespace theory {
 namespace quantifiers {
 namespace inst {
 
+class MatchCodeTree;
+
 /** InstMatchGeneratorSimple class
  *
  * This is the default generator class for simple single triggers.
@@ -42,12 +45,21 @@ namespace inst {
  * The implementation traverses the term indices in TermDatabase for adding
  * instantiations, which is more efficient than the techniques required for
  * handling non-simple single triggers.
+ *
+ * If a code tree is provided, triggers without polarity information are
+ * instead matched via the code tree, which shares the matching work among
+ * all triggers that agree up to variable renaming or on a prefix of their
+ * arguments. With --e-matching-inc, only matches that changed since all
+ * matches were last processed are considered.
  */
 class InstMatchGeneratorSimple : public IMGenerator
 {
  public:
   /** constructors */
-  InstMatchGeneratorSimple(Trigger* tparent, Node q, Node pat);
+  InstMatchGeneratorSimple(Trigger* tparent,
+                           Node q,
+                           Node pat,
+                           MatchCodeTree* mct = nullptr);
 
   /** Reset instantiation round. */
   void resetInstantiationRound() override;
@@ -83,6 +95,17 @@ class InstMatchGeneratorSimple : public IMGenerator
    * child is not a variable.
    */
   std::map<size_t, int> d_var_num;
+  /** The code tree used for matching, if any */
+  MatchCodeTree* d_codeTree;
+  /** The identifier of d_match_pattern in d_codeTree */
+  size_t d_patternId;
+  /**
+   * The last round in which all matches from d_codeTree were processed and
+   * led to instantiations that were added, or zero if there is none. Used for
+   * incremental E-matching. This depends on the SAT context, since matches
+   * that were processed in a branch that was backtracked may be needed again.
+   */
+  context::CDO<uint64_t> d_lastCompleteRound;
   /** add instantiations, helper function.
    *
    * @param m the current match we are building,
@@ -20,6 +20,7 @@
 #include "theory/quantifiers/ematching/inst_strategy_e_matching_user.h"
 #include "theory/quantifiers/ematching/trigger.h"
 #include "theory/quantifiers/first_order_model.h"
+#include "theory/quantifiers/instantiate.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
 #include "theory/quantifiers/term_database.h"
 #include "theory/quantifiers/term_util.h"
@@ -81,10 +82,18 @@ void InstantiationEngine::doInstantiationRound( Theory::Effort effort ){
   int e = 0;
   int eLimit = effort==Theory::EFFORT_LAST_CALL ? 10 : 2;
   bool finished = false;
+  // If batching, the candidate instantiations for all quantified formulas at
+  // an effort level are computed first, and added afterwards.
+  bool batch = options().quantifiers.eMatchingBatch;
+  Instantiate* ie = d_qim.getInstantiate();
   //while unfinished, try effort level=0,1,2....
   while( !finished && e<=eLimit ){
     Debug("inst-engine") << "IE: Prepare instantiation (" << e << ")." << std::endl;
     finished = true;
+    if (batch)
+    {
+      ie->beginBatch();
+    }
     //instantiate each quantifier
     for( unsigned i=0; i<d_quants.size(); i++ ){
       Node q = d_quants[i];
@@ -104,6 +113,10 @@ void InstantiationEngine::doInstantiationRound( Theory::Effort effort ){
               << ", conflict=" << d_qstate.isInConflict() << std::endl;
           if (d_qstate.isInConflict())
           {
+            if (batch)
+            {
+              ie->endBatch(false);
+            }
             return;
           }
           else if (quantStatus == InstStrategyStatus::STATUS_UNFINISHED)
@@ -113,6 +126,14 @@ void InstantiationEngine::doInstantiationRound( Theory::Effort effort ){
         }
       }
     }
+    if (batch)
+    {
+      ie->endBatch();
+      if (d_qstate.isInConflict())
+      {
+        return;
+      }
+    }
     //do not consider another level if already added lemma at this level
     if (d_qim.numPendingLemmas() > lastWaiting)
     {
@@ -127,6 +148,8 @@ bool InstantiationEngine::needsCheck( Theory::Effort e ){
 }
 
 void InstantiationEngine::reset_round( Theory::Effort e ){
+  // matches computed for triggers in the previous round are outdated
+  d_trdb.resetInstantiationRound();
   //if not, proceed to instantiation round
   //reset the instantiation strategies
   for( unsigned i=0; i<d_instStrategies.size(); ++i ){
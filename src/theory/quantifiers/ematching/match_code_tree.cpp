@@ -0,0 +1,225 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A code tree for matching simple triggers.
+ */
+
+#include "theory/quantifiers/ematching/match_code_tree.h"
+
+#include <algorithm>
+
+#include "options/quantifiers_options.h"
+#include "theory/quantifiers/ematching/trigger_term_info.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
+#include "theory/quantifiers/term_util.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+bool MatchCodeTree::Instr::operator<(const Instr& other) const
+{
+  if (d_kind != other.d_kind)
+  {
+    return d_kind < other.d_kind;
+  }
+  if (d_index != other.d_index)
+  {
+    return d_index < other.d_index;
+  }
+  return d_term < other.d_term;
+}
+
+MatchCodeTree::MatchCodeTree(Env& env, QuantifiersState& qs, TermRegistry& tr)
+    : EnvObj(env),
+      d_qstate(qs),
+      d_treg(tr),
+      d_patterns(
+          statisticsRegistry().registerInt("MatchCodeTree::Patterns")),
+      d_sharedPatterns(
+          statisticsRegistry().registerInt("MatchCodeTree::Shared_Patterns")),
+      d_nodes(statisticsRegistry().registerInt("MatchCodeTree::Nodes")),
+      d_operatorMatches(
+          statisticsRegistry().registerInt("MatchCodeTree::Operator_Matches"))
+{
+}
+
+size_t MatchCodeTree::addPattern(Node q, Node pat)
+{
+  Assert(TriggerTermInfo::isSimpleTrigger(pat));
+  TermDb* tdb = d_treg.getTermDatabase();
+  Node op = tdb->getMatchOperator(pat);
+  Root& root = d_roots[std::make_pair(op, pat.getNumChildren())];
+  root.d_op = op;
+  // the matches of the root must be recomputed to include the new pattern
+  root.d_computed = false;
+  CodeNode* c = &root.d_tree;
+  std::map<Node, size_t> firstOcc;
+  for (size_t i = 0, nchild = pat.getNumChildren(); i < nchild; i++)
+  {
+    Instr instr{InstrKind::CHECK, 0, Node::null()};
+    Node p = pat[i];
+    // same as in InstMatchGeneratorSimple, variables of other quantified
+    // formulas are treated as ground terms
+    if (p.getKind() == INST_CONSTANT
+        && (!options().quantifiers.cegqi || TermUtil::getInstConstAttr(p) == q))
+    {
+      std::map<Node, size_t>::iterator it = firstOcc.find(p);
+      if (it == firstOcc.end())
+      {
+        instr.d_kind = InstrKind::BIND;
+        firstOcc[p] = i;
+      }
+      else
+      {
+        instr.d_kind = InstrKind::COMPARE;
+        instr.d_index = it->second;
+      }
+    }
+    else
+    {
+      instr.d_term = p;
+    }
+    std::map<Instr, CodeNode>::iterator itc = c->d_children.find(instr);
+    if (itc == c->d_children.end())
+    {
+      ++d_nodes;
+      itc = c->d_children.emplace(instr, CodeNode()).first;
+    }
+    c = &itc->second;
+  }
+  ++d_patterns;
+  if (c->d_patternId == s_noPattern)
+  {
+    c->d_patternId = d_matches.size();
+    d_matches.emplace_back();
+    d_patternRoot.push_back(&root);
+  }
+  else
+  {
+    ++d_sharedPatterns;
+  }
+  Trace("match-code-tree") << "Pattern " << pat << " has id " << c->d_patternId
+                           << std::endl;
+  return c->d_patternId;
+}
+
+void MatchCodeTree::resetInstantiationRound()
+{
+  for (Root* r : d_computedRoots)
+  {
+    r->d_computed = false;
+  }
+  d_computedRoots.clear();
+}
+
+std::vector<MatchCodeTree::Match> MatchCodeTree::getMatches(size_t id)
+{
+  Assert(id < d_matches.size());
+  Root* root = d_patternRoot[id];
+  if (!root->d_computed)
+  {
+    ++d_operatorMatches;
+    root->d_computed = true;
+    d_computedRoots.push_back(root);
+    clearMatches(root->d_tree);
+    TNodeTrie* tat = d_treg.getTermDatabase()->getTermArgTrie(root->d_op);
+    if (tat != nullptr)
+    {
+      std::vector<TNode> args;
+      match(root->d_tree, tat, args, 0);
+    }
+  }
+  return d_matches[id];
+}
+
+void MatchCodeTree::clearMatches(const CodeNode& c)
+{
+  if (c.d_patternId != s_noPattern)
+  {
+    d_matches[c.d_patternId].clear();
+  }
+  for (const std::pair<const Instr, CodeNode>& cc : c.d_children)
+  {
+    clearMatches(cc.second);
+  }
+}
+
+uint64_t MatchCodeTree::updateModifiedRound(uint64_t modRound, TNode n) const
+{
+  if (!options().quantifiers.eMatchingInc)
+  {
+    return modRound;
+  }
+  return std::max(modRound, d_treg.getTermDatabase()->getModifiedRound(n));
+}
+
+void MatchCodeTree::match(const CodeNode& c,
+                          TNodeTrie* tat,
+                          std::vector<TNode>& args,
+                          uint64_t modRound)
+{
+  if (c.d_patternId != s_noPattern)
+  {
+    Assert(tat->hasData());
+    TNode t = tat->getData();
+    d_matches[c.d_patternId].push_back(
+        Match{t, updateModifiedRound(modRound, t)});
+  }
+  for (const std::pair<const Instr, CodeNode>& cc : c.d_children)
+  {
+    const Instr& instr = cc.first;
+    if (instr.d_kind == InstrKind::BIND)
+    {
+      for (std::pair<const TNode, TNodeTrie>& tt : tat->d_data)
+      {
+        args.push_back(tt.first);
+        match(cc.second,
+              &tt.second,
+              args,
+              updateModifiedRound(modRound, tt.first));
+        args.pop_back();
+      }
+      continue;
+    }
+    Node r;
+    if (instr.d_kind == InstrKind::COMPARE)
+    {
+      Assert(instr.d_index < args.size());
+      r = args[instr.d_index];
+    }
+    else
+    {
+      r = d_qstate.getRepresentative(instr.d_term);
+    }
+    std::map<TNode, TNodeTrie>::iterator it = tat->d_data.find(r);
+    if (it != tat->d_data.end())
+    {
+      args.push_back(it->first);
+      match(cc.second,
+            &it->second,
+            args,
+            updateModifiedRound(modRound, it->first));
+      args.pop_back();
+    }
+  }
+}
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
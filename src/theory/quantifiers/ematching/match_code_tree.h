@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A code tree for matching simple triggers.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__EMATCHING__MATCH_CODE_TREE_H
+#define CVC5__THEORY__QUANTIFIERS__EMATCHING__MATCH_CODE_TREE_H
+
+#include <map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_trie.h"
+#include "smt/env_obj.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+class TermRegistry;
+
+namespace inst {
+
+/**
+ * A code tree for simple triggers (see TriggerTermInfo::isSimpleTrigger),
+ * in the spirit of the code trees of Simplify and Z3.
+ *
+ * Each simple trigger f(p_1, ..., p_n) is compiled to a sequence of
+ * instructions, one for each argument p_i:
+ * - BIND if p_i is the first occurrence of a variable of its quantified
+ *   formula,
+ * - COMPARE j if p_i is a variable that already occurred as p_j, and
+ * - CHECK p_i if p_i is ground (or a variable of another quantified formula).
+ * Since instructions refer to argument positions instead of variables, the
+ * sequences of triggers that are equal up to variable renaming coincide, even
+ * if they belong to different quantified formulas. The sequences for the same
+ * match operator are stored in a trie, such that common prefixes are shared.
+ *
+ * Matching is done for all patterns of a match operator at once by traversing
+ * the code tree simultaneously with the term index of the operator in the term
+ * database, hence every common prefix is matched only once per instantiation
+ * round. The matching ground terms for each pattern are cached until the next
+ * call to resetInstantiationRound.
+ *
+ * If --e-matching-inc is enabled, each match additionally records the last
+ * round in which the matched term or one of the equivalence classes visited
+ * while matching it was modified (see TermDb::getModifiedRound). This allows
+ * the users of the code tree to skip matches that did not change since they
+ * last processed them.
+ */
+class MatchCodeTree : protected EnvObj
+{
+ public:
+  /** A match of a pattern */
+  struct Match
+  {
+    /** The ground term matching the pattern */
+    Node d_term;
+    /**
+     * The last round in which the match was modified, or zero if
+     * --e-matching-inc is disabled.
+     */
+    uint64_t d_modifiedRound;
+  };
+
+  MatchCodeTree(Env& env, QuantifiersState& qs, TermRegistry& tr);
+
+  /**
+   * Adds the simple trigger pat for quantified formula q to the code tree, and
+   * returns an identifier for its instruction sequence. Patterns that compile
+   * to the same instruction sequence get the same identifier.
+   */
+  size_t addPattern(Node q, Node pat);
+  /** Invalidates all matches computed in the previous round. */
+  void resetInstantiationRound();
+  /**
+   * Returns the ground terms that match the pattern with the given identifier
+   * in the current round, matching all patterns for the same operator if
+   * necessary. The matches are returned by value, since adding patterns while
+   * the caller processes them invalidates references into d_matches.
+   */
+  std::vector<Match> getMatches(size_t id);
+
+ private:
+  /** The kinds of instructions */
+  enum class InstrKind
+  {
+    BIND,
+    COMPARE,
+    CHECK
+  };
+  /** An instruction for matching a single argument */
+  struct Instr
+  {
+    InstrKind d_kind;
+    /** For COMPARE, the argument position of the earlier occurrence */
+    size_t d_index;
+    /** For CHECK, the term that the argument must be equal to */
+    Node d_term;
+    bool operator<(const Instr& other) const;
+  };
+  /** A node of the code tree */
+  struct CodeNode
+  {
+    /** The continuations after the instruction for the next argument */
+    std::map<Instr, CodeNode> d_children;
+    /** The identifier of the pattern ending in this node, if any */
+    size_t d_patternId = s_noPattern;
+  };
+  /** The root of the code tree for a match operator */
+  struct Root
+  {
+    /** The match operator */
+    Node d_op;
+    /** The code tree */
+    CodeNode d_tree;
+    /** Whether the matches for all patterns below were computed */
+    bool d_computed = false;
+  };
+  /** Marks nodes that do not end a pattern */
+  static constexpr size_t s_noPattern = static_cast<size_t>(-1);
+
+  /**
+   * Traverses the code tree node c and the term index tat in parallel, adding
+   * all ground terms found to the matches of the patterns they match.
+   *
+   * @param c the current node of the code tree
+   * @param tat the current node of the term index
+   * @param args the representatives of the arguments matched so far
+   * @param modRound the last round in which one of args was modified
+   */
+  void match(const CodeNode& c,
+             TNodeTrie* tat,
+             std::vector<TNode>& args,
+             uint64_t modRound);
+  /**
+   * Returns the maximum of modRound and the round in which n was last
+   * modified, if --e-matching-inc is enabled.
+   */
+  uint64_t updateModifiedRound(uint64_t modRound, TNode n) const;
+  /** Clears the matches of all patterns ending in or below c. */
+  void clearMatches(const CodeNode& c);
+
+  /** Reference to the quantifiers state */
+  QuantifiersState& d_qstate;
+  /** Reference to the term registry */
+  TermRegistry& d_treg;
+  /** The roots, for each match operator and arity */
+  std::map<std::pair<Node, size_t>, Root> d_roots;
+  /** The root for each pattern identifier */
+  std::vector<Root*> d_patternRoot;
+  /** The matches for each pattern identifier */
+  std::vector<std::vector<Match>> d_matches;
+  /** The roots whose matches were computed in the current round */
+  std::vector<Root*> d_computedRoots;
+
+  /** Number of patterns added */
+  IntStat d_patterns;
+  /** Number of patterns that share their instruction sequence with another */
+  IntStat d_sharedPatterns;
+  /** Number of nodes of the code tree */
+  IntStat d_nodes;
+  /** Number of times the matches of an operator were computed */
+  IntStat d_operatorMatches;
+};
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
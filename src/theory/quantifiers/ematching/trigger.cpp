@@ -49,7 +49,8 @@ Trigger::Trigger(Env& env,
                  QuantifiersRegistry& qr,
                  TermRegistry& tr,
                  Node q,
-                 std::vector<Node>& nodes)
+                 std::vector<Node>& nodes,
+                 MatchCodeTree* mct)
     : EnvObj(env), d_qstate(qs), d_qim(qim), d_qreg(qr), d_treg(tr), d_quant(q)
 {
   // We must ensure that the ground subterms of the trigger have been
@@ -88,7 +89,7 @@ Trigger::Trigger(Env& env,
   if( d_nodes.size()==1 ){
     if (TriggerTermInfo::isSimpleTrigger(d_nodes[0]))
     {
-      d_mg = new InstMatchGeneratorSimple(this, q, d_nodes[0]);
+      d_mg = new InstMatchGeneratorSimple(this, q, d_nodes[0], mct);
       ++(stats.d_triggers);
     }else{
       d_mg = InstMatchGenerator::mkInstMatchGenerator(this, q, d_nodes[0]);
@@ -168,7 +169,12 @@ uint64_t Trigger::addInstantiations()
 
 bool Trigger::sendInstantiation(std::vector<Node>& m, InferenceId id)
 {
-  return d_qim.getInstantiate()->addInstantiation(d_quant, m, id, d_trNode);
+  Instantiate* ie = d_qim.getInstantiate();
+  if (ie->isBatching())
+  {
+    return ie->addCandidate(d_quant, m, id, d_trNode, d_trNode);
+  }
+  return ie->addInstantiation(d_quant, m, id, d_trNode, false, false, d_trNode);
 }
 
 bool Trigger::sendInstantiation(InstMatch& m, InferenceId id)
@@ -39,6 +39,7 @@ namespace inst {
 
 class IMGenerator;
 class InstMatchGenerator;
+class MatchCodeTree;
 /** A collection of nodes representing a trigger.
  *
  * This class encapsulates all implementations of E-matching in cvc5.
@@ -101,14 +102,18 @@ class Trigger : protected EnvObj
   friend class IMGenerator;
 
  public:
-  /** trigger constructor */
+  /**
+   * Trigger constructor. If mct is non-null, it is used for matching simple
+   * triggers.
+   */
   Trigger(Env& env,
           QuantifiersState& qs,
           QuantifiersInferenceManager& qim,
           QuantifiersRegistry& qr,
           TermRegistry& tr,
           Node q,
-          std::vector<Node>& nodes);
+          std::vector<Node>& nodes,
+          MatchCodeTree* mct = nullptr);
   virtual ~Trigger();
   /** get the generator associated with this trigger */
   IMGenerator* getGenerator() { return d_mg; }
@@ -131,6 +136,10 @@ class Trigger : protected EnvObj
   * of the underlying match generator. It can be extended to
   * produce instantiations beyond what is produced by the match generator
   * (for example, see theory/quantifiers/ematching/ho_trigger.h).
+  *
+  * Returns the number of instantiations added. If candidates are batched
+  * (see Instantiate::isBatching), this counts the candidates that were
+  * queued, some of which may be rejected when the batch ends.
   */
   virtual uint64_t addInstantiations();
   /** Return whether this is a multi-trigger. */
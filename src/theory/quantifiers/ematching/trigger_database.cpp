@@ -15,6 +15,7 @@
 
 #include "theory/quantifiers/ematching/trigger_database.h"
 
+#include "options/quantifiers_options.h"
 #include "theory/quantifiers/ematching/ho_trigger.h"
 #include "theory/quantifiers/ematching/trigger.h"
 #include "theory/quantifiers/term_util.h"
@@ -29,7 +30,14 @@ TriggerDatabase::TriggerDatabase(Env& env,
                                  QuantifiersInferenceManager& qim,
                                  QuantifiersRegistry& qr,
                                  TermRegistry& tr)
-    : EnvObj(env), d_qs(qs), d_qim(qim), d_qreg(qr), d_treg(tr)
+    : EnvObj(env),
+      d_codeTree(options().quantifiers.triggerCodeTree
+                     ? new MatchCodeTree(env, qs, tr)
+                     : nullptr),
+      d_qs(qs),
+      d_qim(qim),
+      d_qreg(qr),
+      d_treg(tr)
 {
 }
 TriggerDatabase::~TriggerDatabase() {}
@@ -84,7 +92,8 @@ Trigger* TriggerDatabase::mkTrigger(Node q,
   }
   else
   {
-    t = new Trigger(d_env, d_qs, d_qim, d_qreg, d_treg, q, trNodes);
+    t = new Trigger(
+        d_env, d_qs, d_qim, d_qreg, d_treg, q, trNodes, d_codeTree.get());
   }
   d_trie.addTrigger(trNodes, t);
   return t;
@@ -98,6 +107,14 @@ Trigger* TriggerDatabase::mkTrigger(
   return mkTrigger(q, nodes, keepAll, trOption, useNVars);
 }
 
+void TriggerDatabase::resetInstantiationRound()
+{
+  if (d_codeTree != nullptr)
+  {
+    d_codeTree->resetInstantiationRound();
+  }
+}
+
 bool TriggerDatabase::mkTriggerTerms(Node q,
                                      const std::vector<Node>& nodes,
                                      size_t nvars,
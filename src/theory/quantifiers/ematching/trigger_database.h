@@ -18,10 +18,12 @@
 #ifndef CVC5__THEORY__QUANTIFIERS__TRIGGER_DATABASE_H
 #define CVC5__THEORY__QUANTIFIERS__TRIGGER_DATABASE_H
 
+#include <memory>
 #include <vector>
 
 #include "expr/node.h"
 #include "smt/env_obj.h"
+#include "theory/quantifiers/ematching/match_code_tree.h"
 #include "theory/quantifiers/ematching/trigger_trie.h"
 
 namespace cvc5 {
@@ -92,9 +94,14 @@ class TriggerDatabase : protected EnvObj
                              size_t nvars,
                              std::vector<Node>& trNodes);
 
+  /** Reset instantiation round, called once at the beginning of each round. */
+  void resetInstantiationRound();
+
  private:
   /** The trigger trie, containing the triggers */
   TriggerTrie d_trie;
+  /** The code tree for simple triggers, if --trigger-code-tree is enabled */
+  std::unique_ptr<MatchCodeTree> d_codeTree;
   /** Reference to the quantifiers state */
   QuantifiersState& d_qs;
   /** Reference to the quantifiers inference manager */
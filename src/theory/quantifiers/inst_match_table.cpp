@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of a compact, context-dependent table of instantiations.
+ */
+
+#include "theory/quantifiers/inst_match_table.h"
+
+#include <algorithm>
+
+#include "theory/quantifiers/quantifiers_state.h"
+#include "util/hash.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+InstMatchTable::InstMatchTable(context::Context* c, size_t nvars)
+    : d_nvars(nvars), d_size(c, 0), d_usedSlots(0)
+{
+  Assert(d_nvars > 0);
+}
+
+size_t InstMatchTable::hashTerms(const std::vector<Node>& m)
+{
+  uint64_t hash = fnv1a::offsetBasis;
+  for (const Node& n : m)
+  {
+    hash = fnv1a::fnv1a_64(n.getId(), hash);
+  }
+  return static_cast<size_t>(hash);
+}
+
+bool InstMatchTable::isEntry(size_t index, const std::vector<Node>& m) const
+{
+  const Node* terms = &d_terms[index * d_nvars];
+  for (size_t i = 0; i < d_nvars; i++)
+  {
+    if (terms[i] != m[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t InstMatchTable::findSlot(size_t hash, const std::vector<Node>& m) const
+{
+  Assert(d_usedSlots < d_slots.size());
+  size_t mask = d_slots.size() - 1;
+  uint32_t fingerprint = static_cast<uint32_t>(hash);
+  for (size_t pos = hash & mask;; pos = (pos + 1) & mask)
+  {
+    const Slot& s = d_slots[pos];
+    if (!isLive(s) || (s.d_hash == fingerprint && isEntry(s.d_index, m)))
+    {
+      return pos;
+    }
+  }
+}
+
+bool InstMatchTable::existsInstMatch(QuantifiersState& qs,
+                                     const std::vector<Node>& m,
+                                     bool modEq) const
+{
+  Assert(m.size() == d_nvars);
+  if (d_slots.empty())
+  {
+    return false;
+  }
+  if (isLive(d_slots[findSlot(hashTerms(m), m)]))
+  {
+    return true;
+  }
+  if (!modEq)
+  {
+    return false;
+  }
+  for (size_t index = 0, size = d_size.get(); index < size; index++)
+  {
+    const Node* terms = &d_terms[index * d_nvars];
+    bool isEq = true;
+    for (size_t i = 0; i < d_nvars && isEq; i++)
+    {
+      isEq = terms[i] == m[i]
+             || (!terms[i].isNull() && !m[i].isNull()
+                 && qs.areEqual(terms[i], m[i]));
+    }
+    if (isEq)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool InstMatchTable::addInstMatch(const std::vector<Node>& m)
+{
+  Assert(m.size() == d_nvars);
+  size_t size = d_size.get();
+  if ((d_usedSlots + 1) * 2 > d_slots.size())
+  {
+    rehash();
+  }
+  size_t hash = hashTerms(m);
+  size_t pos = findSlot(hash, m);
+  Slot& s = d_slots[pos];
+  if (isLive(s))
+  {
+    return false;
+  }
+  // drop the entries that were popped from the context
+  d_terms.resize(size * d_nvars);
+  d_terms.insert(d_terms.end(), m.begin(), m.end());
+  Assert(size < s_empty);
+  if (s.d_index == s_empty)
+  {
+    d_usedSlots++;
+  }
+  s.d_hash = static_cast<uint32_t>(hash);
+  s.d_index = static_cast<uint32_t>(size);
+  d_size = size + 1;
+  return true;
+}
+
+bool InstMatchTable::removeInstMatch(const std::vector<Node>& m)
+{
+  Assert(m.size() == d_nvars);
+  if (d_slots.empty())
+  {
+    return false;
+  }
+  const Slot& s = d_slots[findSlot(hashTerms(m), m)];
+  if (!isLive(s))
+  {
+    return false;
+  }
+  // Null terms never occur in instantiations, hence the entry can no longer
+  // be found. We keep the slot in use, as other entries may be probed past it.
+  std::fill_n(d_terms.begin() + s.d_index * d_nvars, d_nvars, Node::null());
+  return true;
+}
+
+void InstMatchTable::getInstantiations(
+    std::vector<std::vector<Node>>& insts) const
+{
+  for (size_t index = 0, size = d_size.get(); index < size; index++)
+  {
+    std::vector<Node>::const_iterator it = d_terms.begin() + index * d_nvars;
+    if (it->isNull())
+    {
+      // removed
+      continue;
+    }
+    insts.emplace_back(it, it + d_nvars);
+  }
+}
+
+size_t InstMatchTable::size() const { return d_size.get(); }
+
+size_t InstMatchTable::getMemoryUsage() const
+{
+  return sizeof(InstMatchTable) + d_terms.capacity() * sizeof(Node)
+         + d_slots.capacity() * sizeof(Slot);
+}
+
+void InstMatchTable::rehash()
+{
+  size_t size = d_size.get();
+  size_t nslots = s_minSlots;
+  while (nslots < (size + 1) * 4)
+  {
+    nslots *= 2;
+  }
+  d_slots.assign(nslots, Slot{0, s_empty});
+  d_usedSlots = size;
+  size_t mask = nslots - 1;
+  std::vector<Node> m(d_nvars);
+  for (size_t index = 0; index < size; index++)
+  {
+    std::vector<Node>::const_iterator it = d_terms.begin() + index * d_nvars;
+    std::copy(it, it + d_nvars, m.begin());
+    size_t hash = hashTerms(m);
+    size_t pos = hash & mask;
+    while (d_slots[pos].d_index != s_empty)
+    {
+      pos = (pos + 1) & mask;
+    }
+    d_slots[pos] = Slot{static_cast<uint32_t>(hash),
+                        static_cast<uint32_t>(index)};
+  }
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
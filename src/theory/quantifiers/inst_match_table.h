@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A compact, context-dependent table of instantiations.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__INST_MATCH_TABLE_H
+#define CVC5__THEORY__QUANTIFIERS__INST_MATCH_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "context/cdo.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+
+/** table of instantiations
+ *
+ * This class stores the instantiations of a quantified formula q for the
+ * purpose of duplicate detection. It serves the same purpose as
+ * (CD)InstMatchTrie, but stores all term tuples in a single flat array
+ * that is indexed by an open-addressed hash table with linear probing.
+ * Each instantiation costs one Node per variable of q plus one slot of
+ * eight bytes in the hash table, instead of one std::map node per variable.
+ *
+ * The table is context-dependent: entries are appended to the term array,
+ * and only the number of entries is stored in a context-dependent object.
+ * Entries beyond this number are dropped lazily when the next entry is
+ * added, and slots of the hash table that refer to them count as free. This
+ * does not break the probing sequences of the remaining entries, since
+ * every slot that precedes the slot of an entry in its probing sequence
+ * refers to an entry that was added before it.
+ */
+class InstMatchTable
+{
+ public:
+  /** nvars is the number of variables of the quantified formula */
+  InstMatchTable(context::Context* c, size_t nvars);
+  /** exists inst match
+   *
+   * Returns true if m was added to this table. If modEq is true, we check for
+   * duplication modulo the current equalities in the equality engine of qs,
+   * which requires a traversal of all entries in the table.
+   */
+  bool existsInstMatch(QuantifiersState& qs,
+                       const std::vector<Node>& m,
+                       bool modEq = false) const;
+  /**
+   * Adds m to this table, and returns true if and only if m was not already
+   * contained in this table.
+   */
+  bool addInstMatch(const std::vector<Node>& m);
+  /**
+   * Removes m from this table, and returns true if and only if m was
+   * contained in this table. Unlike additions, removals are not undone when
+   * the context is popped.
+   */
+  bool removeInstMatch(const std::vector<Node>& m);
+  /** Adds the instantiations stored in this table into insts. */
+  void getInstantiations(std::vector<std::vector<Node>>& insts) const;
+  /** Get the number of instantiations in this table */
+  size_t size() const;
+  /** Get the number of bytes allocated by this table */
+  size_t getMemoryUsage() const;
+
+ private:
+  /** A slot of the hash table */
+  struct Slot
+  {
+    /** The lower bits of the hash value of the entry */
+    uint32_t d_hash;
+    /** The index of the entry, or s_empty */
+    uint32_t d_index;
+  };
+  /** Marks a slot that was never used */
+  static constexpr uint32_t s_empty = static_cast<uint32_t>(-1);
+  /** The minimal number of slots of the hash table */
+  static constexpr size_t s_minSlots = 16;
+  /** Computes the hash value of m */
+  static size_t hashTerms(const std::vector<Node>& m);
+  /** Does slot s refer to an entry in the current context? */
+  bool isLive(const Slot& s) const { return s.d_index < d_size.get(); }
+  /** Does the entry with the given index store m? */
+  bool isEntry(size_t index, const std::vector<Node>& m) const;
+  /**
+   * Returns the position of the slot that refers to m, if one exists, or the
+   * position of the first free slot in the probing sequence of m otherwise.
+   * The table must have at least one free slot.
+   */
+  size_t findSlot(size_t hash, const std::vector<Node>& m) const;
+  /**
+   * Rebuilds the hash table from the entries in the current context, such
+   * that at most a quarter of its slots are in use.
+   */
+  void rehash();
+  /** The number of variables of the quantified formula */
+  size_t d_nvars;
+  /** The number of entries in the current context */
+  context::CDO<size_t> d_size;
+  /** The terms of all entries, d_nvars consecutive terms per entry */
+  std::vector<Node> d_terms;
+  /** The hash table, whose size is a power of two */
+  std::vector<Slot> d_slots;
+  /** The number of slots that are not s_empty */
+  size_t d_usedSlots;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__QUANTIFIERS__INST_MATCH_TABLE_H */
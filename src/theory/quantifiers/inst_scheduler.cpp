@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of usefulness scores and per-round budgets for
+ * instantiations.
+ */
+
+#include "theory/quantifiers/inst_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "options/quantifiers_options.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+InstScheduler::InstScheduler(Env& env)
+    : EnvObj(env),
+      d_throttled(
+          statisticsRegistry().registerInt("InstScheduler::Throttled_Inst")),
+      d_useful(statisticsRegistry().registerInt("InstScheduler::Useful_Inst"))
+{
+}
+
+void InstScheduler::resetRound()
+{
+  for (std::pair<const Node, Score>& s : d_quantScores)
+  {
+    s.second.d_roundCount = 0;
+  }
+  for (std::pair<const Node, Score>& s : d_triggerScores)
+  {
+    s.second.d_roundCount = 0;
+  }
+}
+
+bool InstScheduler::hasBudget(const Score& s) const
+{
+  double budget = std::ceil(options().quantifiers.instBudget * s.d_score);
+  return s.d_roundCount < std::max(1.0, budget);
+}
+
+bool InstScheduler::allowInstantiation(Node q, Node trigger)
+{
+  std::map<Node, Score>::const_iterator it = d_quantScores.find(q);
+  if (it != d_quantScores.end() && !hasBudget(it->second))
+  {
+    ++d_throttled;
+    return false;
+  }
+  if (!trigger.isNull())
+  {
+    it = d_triggerScores.find(trigger);
+    if (it != d_triggerScores.end() && !hasBudget(it->second))
+    {
+      ++d_throttled;
+      return false;
+    }
+  }
+  return true;
+}
+
+void InstScheduler::update(Score& s, bool useful)
+{
+  s.d_score = (1 - s_alpha) * s.d_score + (useful ? s_alpha : 0);
+  s.d_roundCount++;
+  s.d_total++;
+  if (useful)
+  {
+    s.d_useful++;
+  }
+}
+
+void InstScheduler::notifyInstantiation(Node q, Node trigger, bool useful)
+{
+  if (useful)
+  {
+    ++d_useful;
+  }
+  update(d_quantScores[q], useful);
+  if (!trigger.isNull())
+  {
+    update(d_triggerScores[trigger], useful);
+  }
+}
+
+void InstScheduler::debugPrint(const char* c) const
+{
+  for (const std::pair<const Node, Score>& s : d_quantScores)
+  {
+    Trace(c) << " * score " << s.second.d_score << ", " << s.second.d_useful
+             << " / " << s.second.d_total << " useful for " << s.first
+             << std::endl;
+  }
+  for (const std::pair<const Node, Score>& s : d_triggerScores)
+  {
+    Trace(c) << " * score " << s.second.d_score << ", " << s.second.d_useful
+             << " / " << s.second.d_total << " useful for trigger " << s.first
+             << std::endl;
+  }
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Usefulness scores and per-round budgets for instantiations.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__INST_SCHEDULER_H
+#define CVC5__THEORY__QUANTIFIERS__INST_SCHEDULER_H
+
+#include <map>
+
+#include "expr/node.h"
+#include "smt/env_obj.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/**
+ * Instantiation scheduler, which limits the number of instantiations that
+ * are added per quantified formula and trigger in each instantiation round.
+ *
+ * Each quantified formula and each trigger has a usefulness score between
+ * zero and one, which is an exponential moving average over its
+ * instantiations, where an instantiation counts as useful if it was
+ * conflicting or propagating in the current context when it was added. The
+ * budget of a quantified formula (resp. trigger) in a round is the option
+ * instBudget scaled by its score, but at least one. Hence, quantified
+ * formulas whose instantiations are rarely used by the SAT solver, as it is
+ * typical for matching loops, are throttled, while every quantified formula
+ * can still be instantiated in every round.
+ *
+ * This is enabled by the option --inst-budget.
+ */
+class InstScheduler : protected EnvObj
+{
+ public:
+  InstScheduler(Env& env);
+  /** Start a new instantiation round, which resets all budgets. */
+  void resetRound();
+  /**
+   * Returns true if another instantiation of q, which is for the given
+   * trigger (or null if none), fits into the budget of the current round.
+   */
+  bool allowInstantiation(Node q, Node trigger);
+  /**
+   * Notify that an instantiation of q for the given trigger (or null if none)
+   * was added, where useful is whether it was conflicting or propagating.
+   */
+  void notifyInstantiation(Node q, Node trigger, bool useful);
+  /** Print the scores of all quantified formulas on trace c */
+  void debugPrint(const char* c) const;
+
+ private:
+  /** The score and the current budget of a quantified formula or trigger */
+  struct Score
+  {
+    /** The usefulness score */
+    double d_score = 1.0;
+    /** The number of instantiations in the current round */
+    uint64_t d_roundCount = 0;
+    /** The total number of instantiations */
+    uint64_t d_total = 0;
+    /** The number of useful instantiations */
+    uint64_t d_useful = 0;
+  };
+  /** Does s have budget for another instantiation in the current round? */
+  bool hasBudget(const Score& s) const;
+  /** Update s for an instantiation */
+  static void update(Score& s, bool useful);
+  /** The weight of a single instantiation in the moving average */
+  static constexpr double s_alpha = 1.0 / 16;
+  /** The scores of quantified formulas */
+  std::map<Node, Score> d_quantScores;
+  /** The scores of triggers */
+  std::map<Node, Score> d_triggerScores;
+  /** Number of instantiations that were not added due to the budget */
+  IntStat d_throttled;
+  /** Number of instantiations that were useful when added */
+  IntStat d_useful;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__QUANTIFIERS__INST_SCHEDULER_H */
@@ -54,11 +54,16 @@ Instantiate::Instantiate(Env& env,
       d_treg(tr),
       d_insts(userContext()),
       d_c_inst_match_trie_dom(userContext()),
+      d_batching(false),
       d_pfInst(isProofEnabled() ? new CDProof(env.getProofNodeManager(),
                                               userContext(),
                                               "Instantiate::pfInst")
                                 : nullptr)
 {
+  if (options().quantifiers.instBudget > 0)
+  {
+    d_scheduler.reset(new InstScheduler(env));
+  }
 }
 
 Instantiate::~Instantiate()
@@ -76,6 +81,10 @@ bool Instantiate::reset(Theory::Effort e)
   // clear explicitly recorded instantiations
   d_recordedInst.clear();
   d_instDebugTemp.clear();
+  if (d_scheduler != nullptr)
+  {
+    d_scheduler->resetRound();
+  }
   return true;
 }
 
@@ -102,12 +111,17 @@ bool Instantiate::addInstantiation(Node q,
                                    InferenceId id,
                                    Node pfArg,
                                    bool mkRep,
-                                   bool doVts)
+                                   bool doVts,
+                                   Node trigger)
 {
   // For resource-limiting (also does a time check).
   d_qim.safePoint(Resource::QuantifierStep);
   Assert(!d_qstate.isInConflict());
   Assert(terms.size() == q[0].getNumChildren());
+  if (d_batching)
+  {
+    ++(d_statistics.d_batch_bypassed);
+  }
   Trace("inst-add-debug") << "For quantified formula " << q
                           << ", add instantiation: " << std::endl;
   for (unsigned i = 0, size = terms.size(); i < size; i++)
@@ -228,6 +242,25 @@ bool Instantiate::addInstantiation(Node q,
     }
   }
 
+  // check the budget of q and its trigger for this round
+  bool useful = false;
+  if (d_scheduler != nullptr)
+  {
+    // duplicates neither use the budget nor need the usefulness check
+    if (existsInstantiation(q, terms))
+    {
+      Trace("inst-add-debug") << " --> Already exists." << std::endl;
+      ++(d_statistics.d_inst_duplicate_eq);
+      return false;
+    }
+    if (!d_scheduler->allowInstantiation(q, trigger))
+    {
+      Trace("inst-add-debug") << " --> Throttled." << std::endl;
+      return false;
+    }
+    useful = isUsefulInstantiation(q, terms);
+  }
+
   // record the instantiation
   bool recorded = recordInstantiationInternal(q, terms);
   if (!recorded)
@@ -345,6 +378,10 @@ bool Instantiate::addInstantiation(Node q,
   ill->d_list.push_back(body);
   // add to temporary debug statistics (# inst on this round)
   d_instDebugTemp[q]++;
+  if (d_scheduler != nullptr)
+  {
+    d_scheduler->notifyInstantiation(q, trigger, useful);
+  }
   if (Trace.isOn("inst"))
   {
     Trace("inst") << "*** Instantiate " << q << " with " << std::endl;
@@ -505,7 +542,16 @@ bool Instantiate::existsInstantiation(Node q,
                                       const std::vector<Node>& terms,
                                       bool modEq)
 {
-  if (options().base.incrementalSolving)
+  if (options().quantifiers.instTable)
+  {
+    std::map<Node, std::unique_ptr<InstMatchTable>>::iterator it =
+        d_instTable.find(q);
+    if (it != d_instTable.end())
+    {
+      return it->second->existsInstMatch(d_qstate, terms, modEq);
+    }
+  }
+  else if (options().base.incrementalSolving)
   {
     std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
     if (it != d_c_inst_match_trie.end())
@@ -524,6 +570,63 @@ bool Instantiate::existsInstantiation(Node q,
   return false;
 }
 
+void Instantiate::beginBatch()
+{
+  Assert(!d_batching);
+  Assert(d_batch.empty());
+  d_batching = true;
+}
+
+bool Instantiate::addCandidate(Node q,
+                               const std::vector<Node>& terms,
+                               InferenceId id,
+                               Node pfArg,
+                               Node trigger)
+{
+  Assert(d_batching);
+  if (existsInstantiation(q, terms)
+      || !d_batchTrie[q].addInstMatch(d_qstate, q, terms))
+  {
+    Trace("inst-add-debug") << "Duplicate candidate for " << q << std::endl;
+    ++(d_statistics.d_batch_duplicate);
+    return false;
+  }
+  ++(d_statistics.d_batch_candidates);
+  d_batch.push_back(Candidate{q, terms, id, pfArg, trigger});
+  return true;
+}
+
+size_t Instantiate::endBatch(bool doAdd)
+{
+  Assert(d_batching);
+  d_batching = false;
+  size_t added = 0;
+  if (doAdd)
+  {
+    Trace("inst-batch") << "Add batch of " << d_batch.size()
+                        << " candidate instantiations" << std::endl;
+    for (Candidate& c : d_batch)
+    {
+      if (d_qstate.isInConflict())
+      {
+        break;
+      }
+      if (addInstantiation(
+              c.d_q, c.d_terms, c.d_id, c.d_pfArg, false, false, c.d_trigger))
+      {
+        added++;
+      }
+      else
+      {
+        ++(d_statistics.d_batch_rejected);
+      }
+    }
+  }
+  d_batch.clear();
+  d_batchTrie.clear();
+  return added;
+}
+
 Node Instantiate::getInstantiation(Node q,
                                    const std::vector<Node>& vars,
                                    const std::vector<Node>& terms,
@@ -593,6 +696,16 @@ Node Instantiate::getInstantiation(Node q,
 bool Instantiate::recordInstantiationInternal(Node q,
                                               const std::vector<Node>& terms)
 {
+  if (options().quantifiers.instTable)
+  {
+    Trace("inst-add-debug") << "Adding into inst table" << std::endl;
+    std::unique_ptr<InstMatchTable>& imt = d_instTable[q];
+    if (imt == nullptr)
+    {
+      imt.reset(new InstMatchTable(userContext(), q[0].getNumChildren()));
+    }
+    return imt->addInstMatch(terms);
+  }
   if (options().base.incrementalSolving)
   {
     Trace("inst-add-debug")
@@ -612,6 +725,16 @@ bool Instantiate::recordInstantiationInternal(Node q,
 bool Instantiate::removeInstantiationInternal(Node q,
                                               const std::vector<Node>& terms)
 {
+  if (options().quantifiers.instTable)
+  {
+    std::map<Node, std::unique_ptr<InstMatchTable>>::iterator it =
+        d_instTable.find(q);
+    if (it != d_instTable.end())
+    {
+      return it->second->removeInstMatch(terms);
+    }
+    return false;
+  }
   if (options().base.incrementalSolving)
   {
     std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
@@ -637,7 +760,16 @@ void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs) const
 void Instantiate::getInstantiationTermVectors(
     Node q, std::vector<std::vector<Node> >& tvecs)
 {
-  if (options().base.incrementalSolving)
+  if (options().quantifiers.instTable)
+  {
+    std::map<Node, std::unique_ptr<InstMatchTable>>::const_iterator it =
+        d_instTable.find(q);
+    if (it != d_instTable.end())
+    {
+      it->second->getInstantiations(tvecs);
+    }
+  }
+  else if (options().base.incrementalSolving)
   {
     std::map<Node, CDInstMatchTrie*>::const_iterator it =
         d_c_inst_match_trie.find(q);
@@ -660,7 +792,14 @@ void Instantiate::getInstantiationTermVectors(
 void Instantiate::getInstantiationTermVectors(
     std::map<Node, std::vector<std::vector<Node> > >& insts)
 {
-  if (options().base.incrementalSolving)
+  if (options().quantifiers.instTable)
+  {
+    for (const auto& t : d_instTable)
+    {
+      getInstantiationTermVectors(t.first, insts[t.first]);
+    }
+  }
+  else if (options().base.incrementalSolving)
   {
     for (const auto& t : d_c_inst_match_trie)
     {
@@ -706,6 +845,20 @@ void Instantiate::notifyEndRound()
           << " * " << i.second << " for " << i.first << std::endl;
     }
   }
+  if (options().quantifiers.instTable)
+  {
+    size_t bytes = 0;
+    for (const std::pair<const Node, std::unique_ptr<InstMatchTable>>& t :
+         d_instTable)
+    {
+      size_t qbytes = t.second->getMemoryUsage();
+      Trace("inst-table-mem") << " * " << qbytes << " bytes, "
+                              << t.second->size() << " instantiations for "
+                              << t.first << std::endl;
+      bytes += qbytes;
+    }
+    d_statistics.d_instTableBytes = static_cast<int64_t>(bytes);
+  }
   if (isOutputOn(OutputTag::INST))
   {
     bool req = !options().printer.printInstFull;
@@ -724,6 +877,10 @@ void Instantiate::notifyEndRound()
 
 void Instantiate::debugPrintModel()
 {
+  if (d_scheduler != nullptr && Trace.isOn("inst-scheduler"))
+  {
+    d_scheduler->debugPrint("inst-scheduler");
+  }
   if (Trace.isOn("inst-per-quant"))
   {
     for (NodeInstListMap::iterator it = d_insts.begin(); it != d_insts.end();
@@ -751,6 +908,34 @@ Node Instantiate::ensureType(Node n, TypeNode tn)
   return Node::null();
 }
 
+bool Instantiate::isUsefulInstantiation(Node q, const std::vector<Node>& terms)
+{
+  EntailmentCheck* ec = d_treg.getEntailmentCheck();
+  std::map<TNode, TNode> subs;
+  for (size_t i = 0, size = terms.size(); i < size; i++)
+  {
+    subs[q[0][i]] = terms[i];
+  }
+  if (q[1].getKind() != OR)
+  {
+    // an atomic body propagates (or is in conflict) unless it is entailed
+    return !ec->isEntailed(q[1], subs, false, true);
+  }
+  size_t numOpen = 0;
+  for (const Node& lit : q[1])
+  {
+    if (!ec->isEntailed(lit, subs, false, false))
+    {
+      numOpen++;
+      if (numOpen > 1)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 InstLemmaList* Instantiate::getOrMkInstLemmaList(TNode q)
 {
   NodeInstListMap::iterator it = d_insts.find(q);
@@ -772,7 +957,17 @@ Instantiate::Statistics::Statistics()
       d_inst_duplicate_eq(smtStatisticsRegistry().registerInt(
           "Instantiate::Duplicate_Inst_Eq")),
       d_inst_duplicate_ent(smtStatisticsRegistry().registerInt(
-          "Instantiate::Duplicate_Inst_Entailed"))
+          "Instantiate::Duplicate_Inst_Entailed")),
+      d_instTableBytes(
+          smtStatisticsRegistry().registerInt("Instantiate::Inst_Table_Bytes")),
+      d_batch_candidates(smtStatisticsRegistry().registerInt(
+          "Instantiate::Batch_Candidates")),
+      d_batch_duplicate(smtStatisticsRegistry().registerInt(
+          "Instantiate::Batch_Duplicate")),
+      d_batch_rejected(smtStatisticsRegistry().registerInt(
+          "Instantiate::Batch_Rejected")),
+      d_batch_bypassed(smtStatisticsRegistry().registerInt(
+          "Instantiate::Batch_Bypassed"))
 {
 }
 
@@ -19,12 +19,15 @@
 #define CVC5__THEORY__QUANTIFIERS__INSTANTIATE_H
 
 #include <map>
+#include <memory>
 
 #include "context/cdhashset.h"
 #include "expr/node.h"
 #include "proof/proof.h"
 #include "theory/inference_id.h"
+#include "theory/quantifiers/inst_match_table.h"
 #include "theory/quantifiers/inst_match_trie.h"
+#include "theory/quantifiers/inst_scheduler.h"
 #include "theory/quantifiers/quant_util.h"
 #include "util/statistics_stats.h"
 
@@ -145,6 +148,8 @@ class Instantiate : public QuantifiersUtil
    * range of the substitution m,
    * @param doVts whether we must apply virtual term substitution to the
    * instantiation lemma.
+   * @param trigger the trigger that the instantiation was found for, if any,
+   * which is used for scheduling instantiations (see InstScheduler)
    *
    * This call may fail if it can be determined that the instantiation is not
    * relevant or legal in the current context. This happens if:
@@ -155,7 +160,9 @@ class Instantiate : public QuantifiersUtil
    *     fast entailment check (see TermDb::isEntailed),
    * (4) The range of the substitution is a duplicate of that of a previously
    *     added instantiation,
-   * (5) The instantiation lemma is a duplicate of previously added lemma.
+   * (5) The instantiation lemma is a duplicate of previously added lemma,
+   * (6) The budget of q or trigger for the current round is exhausted (see
+   *     InstScheduler).
    *
    */
   bool addInstantiation(Node q,
@@ -163,7 +170,8 @@ class Instantiate : public QuantifiersUtil
                         InferenceId id,
                         Node pfArg = Node::null(),
                         bool mkRep = false,
-                        bool doVts = false);
+                        bool doVts = false,
+                        Node trigger = Node::null());
   /**
    * Same as above, but we also compute a vector failMask indicating which
    * values in terms led to the instantiation not being added when this method
@@ -213,6 +221,44 @@ class Instantiate : public QuantifiersUtil
   bool existsInstantiation(Node q,
                            const std::vector<Node>& terms,
                            bool modEq = false);
+  //--------------------------------------batched instantiations
+  /**
+   * Start a batch, after which addCandidate can be used to collect the
+   * candidate instantiations of several quantified formulas before any of
+   * them is added.
+   */
+  void beginBatch();
+  /** Are we currently collecting a batch of candidate instantiations? */
+  bool isBatching() const { return d_batching; }
+  /**
+   * Add the candidate instantiation of q with terms to the current batch.
+   * Returns false if it is a duplicate of a candidate in the current batch or
+   * of an instantiation that was already added. The remaining arguments are
+   * as in addInstantiation.
+   *
+   * Notice that returning true only means that the candidate was queued. It
+   * may still be rejected by addInstantiation when the batch ends, hence the
+   * number of instantiations that callers (e.g. Trigger::addInstantiations)
+   * report while batching is an upper bound. The candidates that were
+   * rejected when the batch ended are counted by Batch_Rejected.
+   */
+  bool addCandidate(Node q,
+                    const std::vector<Node>& terms,
+                    InferenceId id,
+                    Node pfArg = Node::null(),
+                    Node trigger = Node::null());
+  /**
+   * End the current batch. If doAdd is true, we call addInstantiation for the
+   * candidates of the batch in the order they were collected, until we are in
+   * conflict. Returns the number of instantiations that were added.
+   *
+   * Instantiations that are added by addInstantiation while batching are not
+   * part of the batch. This is the case for higher-order triggers, which try
+   * alternative instantiations until one is added, and hence need the result
+   * of addInstantiation immediately. These are counted by Batch_Bypassed.
+   */
+  size_t endBatch(bool doAdd = true);
+  //--------------------------------------end batched instantiations
   //--------------------------------------general utilities
   /** get instantiation
    *
@@ -292,6 +338,16 @@ class Instantiate : public QuantifiersUtil
     IntStat d_inst_duplicate;
     IntStat d_inst_duplicate_eq;
     IntStat d_inst_duplicate_ent;
+    /** total number of bytes used by the tables in d_instTable */
+    IntStat d_instTableBytes;
+    /** number of candidates collected in batches */
+    IntStat d_batch_candidates;
+    /** number of duplicate candidates filtered in batches */
+    IntStat d_batch_duplicate;
+    /** number of candidates rejected when adding a batch */
+    IntStat d_batch_rejected;
+    /** number of instantiations added directly while batching */
+    IntStat d_batch_bypassed;
     Statistics();
   }; /* class Instantiate::Statistics */
   Statistics d_statistics;
@@ -306,6 +362,13 @@ class Instantiate : public QuantifiersUtil
    * if possible.
    */
   static Node ensureType(Node n, TypeNode tn);
+  /**
+   * Returns true if the instantiation of q with terms is conflicting or
+   * propagating in the current context, i.e. if at most one disjunct of its
+   * body is not entailed to be false. A body that is not a disjunction is
+   * useful unless it is entailed to be true.
+   */
+  bool isUsefulInstantiation(Node q, const std::vector<Node>& terms);
   /** Get or make the instantiation list for quantified formula q */
   InstLemmaList* getOrMkInstLemmaList(TNode q);
 
@@ -348,6 +411,29 @@ class Instantiate : public QuantifiersUtil
    * is valid.
    */
   context::CDHashSet<Node> d_c_inst_match_trie_dom;
+  /**
+   * The instantiations for each quantifier, if the option instTable is
+   * enabled, in which case it is used instead of the above tries regardless
+   * of whether incremental solving is enabled.
+   */
+  std::map<Node, std::unique_ptr<InstMatchTable>> d_instTable;
+  /** The instantiation scheduler, if the option instBudget is set */
+  std::unique_ptr<InstScheduler> d_scheduler;
+  /** A candidate instantiation collected by addCandidate */
+  struct Candidate
+  {
+    Node d_q;
+    std::vector<Node> d_terms;
+    InferenceId d_id;
+    Node d_pfArg;
+    Node d_trigger;
+  };
+  /** Are we collecting a batch? */
+  bool d_batching;
+  /** The candidates of the current batch */
+  std::vector<Candidate> d_batch;
+  /** The candidates of the current batch for each quantified formula */
+  std::map<Node, InstMatchTrie> d_batchTrie;
   /**
    * A CDProof storing instantiation steps.
    */
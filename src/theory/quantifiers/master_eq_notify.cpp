@@ -28,6 +28,11 @@ void MasterNotifyClass::eqNotifyNewClass(TNode t)
   d_quantEngine->eqNotifyNewClass(t);
 }
 
+void MasterNotifyClass::eqNotifyMerge(TNode t1, TNode t2)
+{
+  d_quantEngine->eqNotifyMerge(t1, t2);
+}
+
 
 }  // namespace quantifiers
 }  // namespace theory
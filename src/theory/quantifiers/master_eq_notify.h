@@ -52,7 +52,11 @@ class MasterNotifyClass : public theory::eq::EqualityEngineNotify
     return true;
   }
   void eqNotifyConstantTermMerge(TNode t1, TNode t2) override {}
-  void eqNotifyMerge(TNode t1, TNode t2) override {}
+  /**
+   * Called when two equivalence classes are merged in the master equality
+   * engine.
+   */
+  void eqNotifyMerge(TNode t1, TNode t2) override;
   void eqNotifyDisequal(TNode t1, TNode t2, TNode reason) override {}
 
   private:
@@ -0,0 +1,551 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of evaluation of terms on all examples at once.
+ */
+
+#include "theory/quantifiers/sygus/columnar_evaluator.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+#include "expr/node_manager.h"
+#include "util/bitvector.h"
+#include "util/hash.h"
+#include "util/rational.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+namespace {
+
+/**
+ * Get the type and value of constant c, return false if c is not a
+ * supported constant.
+ */
+bool getConstValue(Node c, Column::Type& t, uint32_t& width, int64_t& val)
+{
+  switch (c.getKind())
+  {
+    case CONST_BOOLEAN:
+      t = Column::Type::BOOL;
+      val = c.getConst<bool>() ? 1 : 0;
+      return true;
+    case CONST_RATIONAL:
+    {
+      const Rational& r = c.getConst<Rational>();
+      if (!r.isIntegral() || r.getNumerator().length() >= 63)
+      {
+        return false;
+      }
+      t = Column::Type::INT;
+      val = r.getNumerator().getSigned64();
+      return true;
+    }
+    case CONST_BITVECTOR:
+    {
+      const BitVector& bv = c.getConst<BitVector>();
+      if (bv.getSize() > 64)
+      {
+        return false;
+      }
+      t = Column::Type::BV;
+      width = bv.getSize();
+      val = static_cast<int64_t>(bv.getValue().getUnsigned64());
+      return true;
+    }
+    default: return false;
+  }
+}
+
+/** Get the mask for bit-vectors of the given width */
+uint64_t getMask(uint32_t width)
+{
+  return width >= 64 ? ~static_cast<uint64_t>(0)
+                     : (static_cast<uint64_t>(1) << width) - 1;
+}
+
+/** Get the signed value of bit-vector value v of the given width */
+int64_t toSigned(uint64_t v, uint32_t width)
+{
+  if (width >= 64)
+  {
+    return static_cast<int64_t>(v);
+  }
+  uint32_t shift = 64 - width;
+  return static_cast<int64_t>(v << shift) >> shift;
+}
+
+}  // namespace
+
+bool Column::operator==(const Column& c) const
+{
+  return d_type == c.d_type && d_width == c.d_width && d_vals == c.d_vals;
+}
+
+size_t Column::hash() const
+{
+  uint64_t ret = fnv1a::fnv1a_64(static_cast<uint64_t>(d_type));
+  ret = fnv1a::fnv1a_64(d_width, ret);
+  for (int64_t v : d_vals)
+  {
+    ret = fnv1a::fnv1a_64(static_cast<uint64_t>(v), ret);
+  }
+  return static_cast<size_t>(ret);
+}
+
+Node Column::toNode(size_t i) const
+{
+  NodeManager* nm = NodeManager::currentNM();
+  switch (d_type)
+  {
+    case Type::BOOL: return nm->mkConst(d_vals[i] != 0);
+    case Type::INT: return nm->mkConstInt(Rational(d_vals[i]));
+    default:
+      return nm->mkConst(
+          BitVector(d_width, Integer(static_cast<uint64_t>(d_vals[i]))));
+  }
+}
+
+ColumnarEvaluator::ColumnarEvaluator(const std::vector<Node>& vars)
+    : d_vars(vars),
+      d_numExamples(0),
+      d_varCols(vars.size()),
+      d_varSupported(vars.size(), true)
+{
+}
+
+void ColumnarEvaluator::addExample(const std::vector<Node>& ex)
+{
+  Assert(ex.size() == d_vars.size());
+  for (size_t i = 0, nvars = d_vars.size(); i < nvars; i++)
+  {
+    if (!d_varSupported[i])
+    {
+      continue;
+    }
+    Column& col = d_varCols[i];
+    Column::Type t = Column::Type::BOOL;
+    uint32_t width = 0;
+    int64_t val;
+    if (!getConstValue(ex[i], t, width, val)
+        || (d_numExamples > 0 && (t != col.d_type || width != col.d_width)))
+    {
+      d_varSupported[i] = false;
+      col.d_vals.clear();
+      continue;
+    }
+    col.d_type = t;
+    col.d_width = width;
+    col.d_vals.push_back(val);
+  }
+  d_numExamples++;
+}
+
+bool ColumnarEvaluator::mkConstColumn(Node c, Column& col) const
+{
+  int64_t val;
+  if (!getConstValue(c, col.d_type, col.d_width, val))
+  {
+    return false;
+  }
+  col.d_vals.assign(d_numExamples, val);
+  return true;
+}
+
+bool ColumnarEvaluator::evaluate(Node n, Column& col) const
+{
+  // the columns computed for the subterms of n
+  std::deque<Column> cols;
+  std::unordered_map<TNode, const Column*> visited;
+  std::unordered_map<TNode, const Column*>::iterator it;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    it = visited.find(cur);
+    if (it == visited.end())
+    {
+      if (cur.isConst())
+      {
+        cols.emplace_back();
+        if (!mkConstColumn(cur, cols.back()))
+        {
+          return false;
+        }
+        visited[cur] = &cols.back();
+        continue;
+      }
+      if (cur.isVar())
+      {
+        std::vector<Node>::const_iterator itv =
+            std::find(d_vars.begin(), d_vars.end(), cur);
+        if (itv == d_vars.end() || !d_varSupported[itv - d_vars.begin()])
+        {
+          return false;
+        }
+        visited[cur] = &d_varCols[itv - d_vars.begin()];
+        continue;
+      }
+      if (cur.getNumChildren() == 0
+          || cur.getMetaKind() == metakind::PARAMETERIZED)
+      {
+        return false;
+      }
+      visited[cur] = nullptr;
+      visit.push_back(cur);
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else if (it->second == nullptr)
+    {
+      std::vector<const Column*> cs;
+      for (const Node& cn : cur)
+      {
+        Assert(visited.find(cn) != visited.end());
+        cs.push_back(visited[cn]);
+      }
+      cols.emplace_back();
+      if (!evaluateOp(cur, cs, cols.back()))
+      {
+        Trace("sygus-columnar") << "...unsupported " << cur << std::endl;
+        return false;
+      }
+      visited[cur] = &cols.back();
+    }
+  } while (!visit.empty());
+  Assert(visited.find(n) != visited.end() && visited[n] != nullptr);
+  col = *visited[n];
+  return true;
+}
+
+bool ColumnarEvaluator::evaluateOp(Node n,
+                                   const std::vector<const Column*>& cs,
+                                   Column& col) const
+{
+  Kind k = n.getKind();
+  size_t nex = d_numExamples;
+  std::vector<int64_t>& res = col.d_vals;
+  res.resize(nex);
+  // check that all children have type t, and the same width
+  auto childrenHaveType = [&cs](Column::Type t) {
+    for (const Column* c : cs)
+    {
+      if (c->d_type != t || c->d_width != cs[0]->d_width)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  // Boolean operators
+  switch (k)
+  {
+    case NOT:
+    case AND:
+    case OR:
+    case XOR:
+    case IMPLIES:
+    {
+      if (!childrenHaveType(Column::Type::BOOL))
+      {
+        return false;
+      }
+      col.d_type = Column::Type::BOOL;
+      res = cs[0]->d_vals;
+      if (k == NOT)
+      {
+        for (size_t j = 0; j < nex; j++)
+        {
+          res[j] = 1 - res[j];
+        }
+        return true;
+      }
+      if (k == IMPLIES)
+      {
+        for (size_t j = 0; j < nex; j++)
+        {
+          res[j] = 1 - res[j];
+        }
+      }
+      for (size_t i = 1, nchild = cs.size(); i < nchild; i++)
+      {
+        const std::vector<int64_t>& b = cs[i]->d_vals;
+        for (size_t j = 0; j < nex; j++)
+        {
+          res[j] = k == AND ? (res[j] & b[j])
+                            : (k == XOR ? (res[j] ^ b[j]) : (res[j] | b[j]));
+        }
+      }
+      return true;
+    }
+    case ITE:
+    {
+      if (cs[0]->d_type != Column::Type::BOOL
+          || cs[1]->d_type != cs[2]->d_type
+          || cs[1]->d_width != cs[2]->d_width)
+      {
+        return false;
+      }
+      col.d_type = cs[1]->d_type;
+      col.d_width = cs[1]->d_width;
+      const std::vector<int64_t>& c = cs[0]->d_vals;
+      const std::vector<int64_t>& t = cs[1]->d_vals;
+      const std::vector<int64_t>& e = cs[2]->d_vals;
+      for (size_t j = 0; j < nex; j++)
+      {
+        res[j] = c[j] != 0 ? t[j] : e[j];
+      }
+      return true;
+    }
+    case EQUAL:
+    {
+      if (!childrenHaveType(cs[0]->d_type))
+      {
+        return false;
+      }
+      col.d_type = Column::Type::BOOL;
+      const std::vector<int64_t>& a = cs[0]->d_vals;
+      const std::vector<int64_t>& b = cs[1]->d_vals;
+      for (size_t j = 0; j < nex; j++)
+      {
+        res[j] = a[j] == b[j] ? 1 : 0;
+      }
+      return true;
+    }
+    default: break;
+  }
+  // integer operators
+  switch (k)
+  {
+    case PLUS:
+    case MINUS:
+    case MULT:
+    case NONLINEAR_MULT:
+    case UMINUS:
+    case ABS:
+    case LT:
+    case LEQ:
+    case GT:
+    case GEQ:
+    {
+      if (!childrenHaveType(Column::Type::INT))
+      {
+        return false;
+      }
+      bool isPred = k == LT || k == LEQ || k == GT || k == GEQ;
+      col.d_type = isPred ? Column::Type::BOOL : Column::Type::INT;
+      const std::vector<int64_t>& a = cs[0]->d_vals;
+      if (isPred)
+      {
+        const std::vector<int64_t>& b = cs[1]->d_vals;
+        for (size_t j = 0; j < nex; j++)
+        {
+          switch (k)
+          {
+            case LT: res[j] = a[j] < b[j]; break;
+            case LEQ: res[j] = a[j] <= b[j]; break;
+            case GT: res[j] = a[j] > b[j]; break;
+            default: res[j] = a[j] >= b[j]; break;
+          }
+        }
+        return true;
+      }
+      bool overflow = false;
+      if (k == UMINUS || k == ABS)
+      {
+        for (size_t j = 0; j < nex; j++)
+        {
+          overflow |= __builtin_sub_overflow(0, a[j], &res[j]);
+          if (k == ABS && a[j] >= 0)
+          {
+            res[j] = a[j];
+          }
+        }
+        return !overflow;
+      }
+      res = a;
+      for (size_t i = 1, nchild = cs.size(); i < nchild; i++)
+      {
+        const std::vector<int64_t>& b = cs[i]->d_vals;
+        for (size_t j = 0; j < nex; j++)
+        {
+          if (k == PLUS)
+          {
+            overflow |= __builtin_add_overflow(res[j], b[j], &res[j]);
+          }
+          else if (k == MINUS)
+          {
+            overflow |= __builtin_sub_overflow(res[j], b[j], &res[j]);
+          }
+          else
+          {
+            overflow |= __builtin_mul_overflow(res[j], b[j], &res[j]);
+          }
+        }
+      }
+      return !overflow;
+    }
+    default: break;
+  }
+  // bit-vector operators
+  if (!childrenHaveType(Column::Type::BV))
+  {
+    return false;
+  }
+  uint32_t w = cs[0]->d_width;
+  uint64_t mask = getMask(w);
+  col.d_type = Column::Type::BV;
+  col.d_width = w;
+  const std::vector<int64_t>& a = cs[0]->d_vals;
+  switch (k)
+  {
+    case BITVECTOR_NOT:
+    case BITVECTOR_NEG:
+    {
+      for (size_t j = 0; j < nex; j++)
+      {
+        uint64_t v = static_cast<uint64_t>(a[j]);
+        v = k == BITVECTOR_NOT ? ~v : ~v + 1;
+        res[j] = static_cast<int64_t>(v & mask);
+      }
+      return true;
+    }
+    case BITVECTOR_ADD:
+    case BITVECTOR_MULT:
+    case BITVECTOR_AND:
+    case BITVECTOR_OR:
+    case BITVECTOR_XOR:
+    {
+      res = a;
+      for (size_t i = 1, nchild = cs.size(); i < nchild; i++)
+      {
+        const std::vector<int64_t>& b = cs[i]->d_vals;
+        for (size_t j = 0; j < nex; j++)
+        {
+          uint64_t x = static_cast<uint64_t>(res[j]);
+          uint64_t y = static_cast<uint64_t>(b[j]);
+          uint64_t v;
+          switch (k)
+          {
+            case BITVECTOR_ADD: v = x + y; break;
+            case BITVECTOR_MULT: v = x * y; break;
+            case BITVECTOR_AND: v = x & y; break;
+            case BITVECTOR_OR: v = x | y; break;
+            default: v = x ^ y; break;
+          }
+          res[j] = static_cast<int64_t>(v & mask);
+        }
+      }
+      return true;
+    }
+    case BITVECTOR_SUB:
+    case BITVECTOR_NAND:
+    case BITVECTOR_NOR:
+    case BITVECTOR_XNOR:
+    case BITVECTOR_UDIV:
+    case BITVECTOR_UREM:
+    case BITVECTOR_SHL:
+    case BITVECTOR_LSHR:
+    case BITVECTOR_ASHR:
+    case BITVECTOR_COMP:
+    {
+      const std::vector<int64_t>& b = cs[1]->d_vals;
+      if (k == BITVECTOR_COMP)
+      {
+        col.d_width = 1;
+      }
+      for (size_t j = 0; j < nex; j++)
+      {
+        uint64_t x = static_cast<uint64_t>(a[j]);
+        uint64_t y = static_cast<uint64_t>(b[j]);
+        uint64_t v;
+        switch (k)
+        {
+          case BITVECTOR_SUB: v = x - y; break;
+          case BITVECTOR_NAND: v = ~(x & y); break;
+          case BITVECTOR_NOR: v = ~(x | y); break;
+          case BITVECTOR_XNOR: v = ~(x ^ y); break;
+          // division by zero is all ones, remainder by zero is the dividend
+          case BITVECTOR_UDIV: v = y == 0 ? mask : x / y; break;
+          case BITVECTOR_UREM: v = y == 0 ? x : x % y; break;
+          case BITVECTOR_SHL: v = y >= w ? 0 : x << y; break;
+          case BITVECTOR_LSHR: v = y >= w ? 0 : x >> y; break;
+          case BITVECTOR_ASHR:
+          {
+            int64_t sx = toSigned(x, w);
+            v = static_cast<uint64_t>(y >= w ? (sx < 0 ? -1 : 0) : sx >> y);
+            break;
+          }
+          default: v = x == y ? 1 : 0; break;
+        }
+        res[j] = static_cast<int64_t>(v & mask);
+      }
+      return true;
+    }
+    case BITVECTOR_ULT:
+    case BITVECTOR_ULE:
+    case BITVECTOR_UGT:
+    case BITVECTOR_UGE:
+    case BITVECTOR_SLT:
+    case BITVECTOR_SLE:
+    case BITVECTOR_SGT:
+    case BITVECTOR_SGE:
+    {
+      col.d_type = Column::Type::BOOL;
+      col.d_width = 0;
+      const std::vector<int64_t>& b = cs[1]->d_vals;
+      bool isSigned = k == BITVECTOR_SLT || k == BITVECTOR_SLE
+                      || k == BITVECTOR_SGT || k == BITVECTOR_SGE;
+      for (size_t j = 0; j < nex; j++)
+      {
+        uint64_t x = static_cast<uint64_t>(a[j]);
+        uint64_t y = static_cast<uint64_t>(b[j]);
+        // compare x and y, either as signed or unsigned values
+        int c;
+        if (isSigned)
+        {
+          int64_t sx = toSigned(x, w);
+          int64_t sy = toSigned(y, w);
+          c = sx < sy ? -1 : (sx == sy ? 0 : 1);
+        }
+        else
+        {
+          c = x < y ? -1 : (x == y ? 0 : 1);
+        }
+        switch (k)
+        {
+          case BITVECTOR_ULT:
+          case BITVECTOR_SLT: res[j] = c < 0; break;
+          case BITVECTOR_ULE:
+          case BITVECTOR_SLE: res[j] = c <= 0; break;
+          case BITVECTOR_UGT:
+          case BITVECTOR_SGT: res[j] = c > 0; break;
+          default: res[j] = c >= 0; break;
+        }
+      }
+      return true;
+    }
+    default: break;
+  }
+  return false;
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
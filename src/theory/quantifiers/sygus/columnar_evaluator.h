@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Evaluation of terms on all examples at once.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__SYGUS__COLUMNAR_EVALUATOR_H
+#define CVC5__THEORY__QUANTIFIERS__SYGUS__COLUMNAR_EVALUATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/**
+ * The values of a term on all examples, which are Booleans, integers that
+ * fit into 64 bits or bit-vectors of width at most 64.
+ */
+struct Column
+{
+  /** The type of the values */
+  enum class Type
+  {
+    BOOL,
+    INT,
+    BV
+  };
+  Type d_type = Type::BOOL;
+  /** The width, if d_type is BV */
+  uint32_t d_width = 0;
+  /**
+   * The value on each example, where Booleans are 0 or 1 and bit-vectors are
+   * stored as unsigned values.
+   */
+  std::vector<int64_t> d_vals;
+  /** Returns true if c has the same type and values as this column */
+  bool operator==(const Column& c) const;
+  /** Get a hash of the values of this column */
+  size_t hash() const;
+  /** Convert the value on the i^th example to a constant */
+  Node toNode(size_t i) const;
+};
+
+/**
+ * Evaluates terms on a list of examples, where the values of a term on all
+ * examples are computed at once and are stored in a column (see Column).
+ * Each operator of the term is evaluated by a single loop over the examples,
+ * on plain integer arrays, which avoids constructing intermediate constant
+ * nodes and can be vectorized by the compiler.
+ *
+ * This only supports a fragment of Boolean, linear and non-linear integer
+ * and fixed-width bit-vector operators, whose values fit into 64 bits.
+ * Evaluation fails on other terms, and if integer arithmetic overflows, in
+ * which case the caller must fall back to the (per-example) Evaluator.
+ */
+class ColumnarEvaluator
+{
+ public:
+  /** Construct the evaluator for terms whose free variables are in vars */
+  ColumnarEvaluator(const std::vector<Node>& vars);
+  /** Add the example whose values for the variables are ex */
+  void addExample(const std::vector<Node>& ex);
+  /** Get the number of examples */
+  size_t getNumExamples() const { return d_numExamples; }
+  /**
+   * Evaluate n on all examples, store the result in col. Returns false if n
+   * is not supported.
+   */
+  bool evaluate(Node n, Column& col) const;
+
+ private:
+  /** Make the column for constant c, return false if c is not supported */
+  bool mkConstColumn(Node c, Column& col) const;
+  /**
+   * Evaluate the application n of an operator to the children with columns
+   * cs, store the result in col. Returns false if it is not supported.
+   */
+  bool evaluateOp(Node n,
+                  const std::vector<const Column*>& cs,
+                  Column& col) const;
+  /** The variables */
+  std::vector<Node> d_vars;
+  /** The number of examples */
+  size_t d_numExamples;
+  /** The columns of the variables */
+  std::vector<Column> d_varCols;
+  /** Whether all values of each variable are supported */
+  std::vector<bool> d_varSupported;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__QUANTIFIERS__SYGUS__COLUMNAR_EVALUATOR_H */
@@ -39,16 +39,22 @@ EnumValueManager::EnumValueManager(Env& env,
                                    TermRegistry& tr,
                                    SygusStatistics& s,
                                    Node e,
-                                   bool hasExamples)
+                                   bool hasExamples,
+                                   bool useShards)
     : EnvObj(env),
       d_enum(e),
+      d_useShards(useShards),
       d_qstate(qs),
       d_qim(qim),
       d_treg(tr),
       d_stats(s),
-      d_tds(tr.getTermDatabaseSygus()),
-      d_eec(hasExamples ? new ExampleEvalCache(d_tds, e) : nullptr)
+      d_tds(tr.getTermDatabaseSygus())
 {
+  if (hasExamples)
+  {
+    d_eec.reset(new ExampleEvalCache(
+        d_tds, e, options().quantifiers.sygusEvalColumnar));
+  }
 }
 
 EnumValueManager::~EnumValueManager() {}
@@ -123,7 +129,9 @@ Node EnumValueManager::getEnumeratedValue(bool& activeIncomplete)
             d_secd.get(),
             &d_stats,
             false,
-            options().quantifiers.sygusRepairConst);
+            options().quantifiers.sygusRepairConst,
+            d_useShards ? options().quantifiers.sygusEnumShards : 1,
+            d_useShards ? options().quantifiers.sygusEnumShardIndex : 0);
       }
     }
     Trace("sygus-active-gen")
@@ -214,6 +222,11 @@ Node EnumValueManager::getEnumeratedValue(bool& activeIncomplete)
       Trace("sygus-active-gen-debug") << std::endl;
     }
     d_qim.lemma(lem, InferenceId::QUANTIFIERS_SYGUS_EXCLUDE_CURRENT);
+    if (d_useShards && options().quantifiers.sygusEnumShards > 1)
+    {
+      // the other shards may contain a solution
+      d_qim.setIncomplete(IncompleteId::QUANTIFIERS_SYGUS_SHARD);
+    }
   }
   else
   {
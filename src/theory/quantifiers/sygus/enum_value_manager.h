@@ -42,13 +42,18 @@ class SygusStatistics;
 class EnumValueManager : protected EnvObj
 {
  public:
+  /**
+   * If useShards is true, the fast enumerator for e only generates the
+   * values of the shard given by --sygus-enum-shard-index.
+   */
   EnumValueManager(Env& env,
                    QuantifiersState& qs,
                    QuantifiersInferenceManager& qim,
                    TermRegistry& tr,
                    SygusStatistics& s,
                    Node e,
-                   bool hasExamples);
+                   bool hasExamples,
+                   bool useShards = false);
   ~EnumValueManager();
   /**
    * Get model value for term n. If n has a value that was excluded by
@@ -74,6 +79,8 @@ class EnumValueManager : protected EnvObj
   Node getModelValue(Node n);
   /** The enumerator */
   Node d_enum;
+  /** Whether the fast enumerator only generates the values of one shard */
+  bool d_useShards;
   /** Reference to the quantifiers state */
   QuantifiersState& d_qstate;
   /** Reference to the quantifiers inference manager */
@@ -23,9 +23,8 @@ namespace cvc5 {
 namespace theory {
 namespace quantifiers {
 
-ExampleEvalCache::ExampleEvalCache(TermDbSygus* tds,
-                                   Node e)
-    : d_tds(tds), d_stn(e.getType())
+ExampleEvalCache::ExampleEvalCache(TermDbSygus* tds, Node e, bool useColumnar)
+    : d_tds(tds), d_stn(e.getType()), d_useColumnar(useColumnar)
 {
   d_indexSearchVals = !d_tds->isVariableAgnosticEnumerator(e);
 }
@@ -35,6 +34,10 @@ ExampleEvalCache::~ExampleEvalCache() {}
 void ExampleEvalCache::addExample(const std::vector<Node>& ex)
 {
   d_examples.push_back(ex);
+  if (d_colEval != nullptr)
+  {
+    d_colEval->addExample(ex);
+  }
 }
 
 Node ExampleEvalCache::addSearchVal(TypeNode tn, Node bv)
@@ -44,8 +47,37 @@ Node ExampleEvalCache::addSearchVal(TypeNode tn, Node bv)
     // not indexing search values
     return Node::null();
   }
+  Column col;
+  bool hasCol = d_exOutCache.find(bv) == d_exOutCache.end()
+                && evaluateColumnar(bv, col);
+  std::vector<std::pair<Node, Column>>* colBucket = nullptr;
+  if (hasCol)
+  {
+    // check whether a previous search value has the same values
+    colBucket = &d_colIndex[tn][col.hash()];
+    for (const std::pair<Node, Column>& p : *colBucket)
+    {
+      if (p.second == col)
+      {
+        Trace("sygus-pbe-debug")
+            << "...got " << p.first << " by columnar index" << std::endl;
+        return p.first;
+      }
+    }
+  }
   std::vector<Node> vals;
-  evaluateVec(bv, vals, true);
+  if (hasCol)
+  {
+    for (size_t i = 0, nex = col.d_vals.size(); i < nex; i++)
+    {
+      vals.push_back(col.toNode(i));
+    }
+    d_exOutCache[bv] = vals;
+  }
+  else
+  {
+    evaluateVec(bv, vals, true);
+  }
   Trace("sygus-pbe-debug") << "Add to trie..." << std::endl;
   Node ret = d_trie[tn].addOrGetTerm(bv, vals);
   Trace("sygus-pbe-debug") << "...got " << ret << std::endl;
@@ -57,6 +89,10 @@ Node ExampleEvalCache::addSearchVal(TypeNode tn, Node bv)
   {
     clearEvaluationCache(bv);
   }
+  else if (hasCol)
+  {
+    colBucket->emplace_back(bv, col);
+  }
   Assert(ret.getType().isComparableTo(bv.getType()));
   return ret;
 }
@@ -82,9 +118,17 @@ void ExampleEvalCache::evaluateVec(Node bv,
   }
 }
 
-void ExampleEvalCache::evaluateVecInternal(Node bv,
-                                           std::vector<Node>& exOut) const
+void ExampleEvalCache::evaluateVecInternal(Node bv, std::vector<Node>& exOut)
 {
+  Column col;
+  if (evaluateColumnar(bv, col))
+  {
+    for (size_t i = 0, nex = col.d_vals.size(); i < nex; i++)
+    {
+      exOut.push_back(col.toNode(i));
+    }
+    return;
+  }
   // use ExampleMinEval
   SygusTypeInfo& ti = d_tds->getTypeInfo(d_stn);
   const std::vector<Node>& varlist = ti.getVarList();
@@ -97,6 +141,24 @@ void ExampleEvalCache::evaluateVecInternal(Node bv,
   }
 }
 
+bool ExampleEvalCache::evaluateColumnar(Node bv, Column& col)
+{
+  if (!d_useColumnar)
+  {
+    return false;
+  }
+  if (d_colEval == nullptr)
+  {
+    SygusTypeInfo& ti = d_tds->getTypeInfo(d_stn);
+    d_colEval.reset(new ColumnarEvaluator(ti.getVarList()));
+    for (const std::vector<Node>& ex : d_examples)
+    {
+      d_colEval->addExample(ex);
+    }
+  }
+  return d_colEval->evaluate(bv, col);
+}
+
 Node ExampleEvalCache::evaluate(Node bn, unsigned i) const
 {
   Assert(i < d_examples.size());
@@ -18,7 +18,11 @@
 #ifndef CVC5__THEORY__QUANTIFIERS__EXAMPLE_EVAL_CACHE_H
 #define CVC5__THEORY__QUANTIFIERS__EXAMPLE_EVAL_CACHE_H
 
+#include <memory>
+#include <unordered_map>
+
 #include "expr/node_trie.h"
+#include "theory/quantifiers/sygus/columnar_evaluator.h"
 #include "theory/quantifiers/sygus/example_infer.h"
 
 namespace cvc5 {
@@ -71,9 +75,10 @@ class ExampleEvalCache
    * This initializes this class for function-to-synthesize f and enumerator
    * e. In particular, the terms that will be evaluated by this class
    * are builtin terms that the analog of values taken by enumerator e that
-   * is associated with f.
+   * is associated with f. If useColumnar is true, terms are evaluated on all
+   * examples at once by a ColumnarEvaluator whenever possible.
    */
-  ExampleEvalCache(TermDbSygus* tds, Node e);
+  ExampleEvalCache(TermDbSygus* tds, Node e, bool useColumnar = false);
   ~ExampleEvalCache();
   /**
    * Add example to the list of examples maintained by this class.
@@ -135,7 +140,12 @@ class ExampleEvalCache
 
  private:
   /** Version of evaluateVec that does not do caching */
-  void evaluateVecInternal(Node bv, std::vector<Node>& exOut) const;
+  void evaluateVecInternal(Node bv, std::vector<Node>& exOut);
+  /**
+   * Evaluate bv on all examples with the columnar evaluator, return false if
+   * it is not enabled or does not support bv.
+   */
+  bool evaluateColumnar(Node bv, Column& col);
   /** Pointer to the sygus term database */
   TermDbSygus* d_tds;
   /** pointer to the example inference class */
@@ -161,6 +171,19 @@ class ExampleEvalCache
   std::map< TypeNode, NodeTrie> d_trie;
   /** cache for evaluate */
   std::map<Node, std::vector<Node>> d_exOutCache;
+  /** Whether we use the columnar evaluator */
+  bool d_useColumnar;
+  /** The columnar evaluator, which is constructed lazily */
+  std::unique_ptr<ColumnarEvaluator> d_colEval;
+  /**
+   * Map from sygus types and hashes of columns to the search values with
+   * that hash, and their column. This allows recognizing redundant search
+   * values without converting their values to nodes. Search values that
+   * are not supported by the columnar evaluator are only indexed in d_trie.
+   */
+  std::map<TypeNode,
+           std::unordered_map<size_t, std::vector<std::pair<Node, Column>>>>
+      d_colIndex;
 };
 
 }  // namespace quantifiers
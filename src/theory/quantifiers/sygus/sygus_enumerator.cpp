@@ -38,14 +38,19 @@ SygusEnumerator::SygusEnumerator(Env& env,
                                  SygusEnumeratorCallback* sec,
                                  SygusStatistics* s,
                                  bool enumShapes,
-                                 bool enumAnyConstHoles)
+                                 bool enumAnyConstHoles,
+                                 uint64_t numShards,
+                                 uint64_t shardIndex)
     : EnumValGenerator(env),
       d_tds(tds),
       d_sec(sec),
       d_stats(s),
       d_enumShapes(enumShapes),
       d_enumAnyConstHoles(enumAnyConstHoles),
+      d_numShards(numShards),
+      d_shardIndex(shardIndex),
       d_tlEnum(nullptr),
+      d_tlMaster(nullptr),
       d_abortSize(-1)
 {
 }
@@ -66,6 +71,7 @@ void SygusEnumerator::initialize(Node e)
   Assert(d_etype.isDatatype());
   Assert(d_etype.getDType().isSygus());
   d_tlEnum = getMasterEnumForType(d_etype);
+  d_tlMaster = &d_masterEnum[d_etype];
   d_abortSize = options().datatypes.sygusAbortSize;
 
   // if we don't have a term database, we don't register symmetry breaking
@@ -166,6 +172,15 @@ Node SygusEnumerator::getCurrent()
       ret = Node::null();
     }
   }
+  if (!ret.isNull() && d_numShards > 1
+      && d_tlMaster->getCurrentSlice() % d_numShards != d_shardIndex)
+  {
+    // the current term belongs to another shard
+    Trace("sygus-enum-exc")
+        << "Exclude (shard) : " << datatypes::utils::sygusToBuiltin(ret)
+        << std::endl;
+    ret = Node::null();
+  }
   if (Trace.isOn("sygus-enum"))
   {
     Trace("sygus-enum") << "Enumerate : ";
@@ -592,6 +607,7 @@ SygusEnumerator::TermEnumMaster::TermEnumMaster()
       d_isIncrementing(false),
       d_currTermSet(false),
       d_consClassNum(0),
+      d_sliceNum(0),
       d_ccWeight(0),
       d_consNum(0),
       d_currChildSize(0),
@@ -610,6 +626,7 @@ bool SygusEnumerator::TermEnumMaster::initialize(SygusEnumerator* se,
   d_currSize = 0;
   // we will start with constructor class zero
   d_consClassNum = 0;
+  d_sliceNum = 0;
   d_currChildSize = 0;
   d_ccCons.clear();
   d_enumShapes = se->isEnumShapes();
@@ -737,6 +754,10 @@ bool SygusEnumerator::TermEnumMaster::incrementInternal()
         Trace("sygus-enum-debug2") << "master(" << d_tn
                                    << "): failed due to init size\n";
       }
+      else
+      {
+        d_sliceNum++;
+      }
     }
     else
     {
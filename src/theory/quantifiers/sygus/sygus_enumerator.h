@@ -70,13 +70,20 @@ class SygusEnumerator : public EnumValGenerator
    * number of free variables
    * @param enumAnyConstHoles If true, this enumerator will generate terms where
    * free variables are the arguments to any-constant constructors.
+   * @param numShards The number of shards the values of this enumerator are
+   * split into, where the terms of the i^th (size, constructor class) slice
+   * of the top-level type, counting from zero, belong to shard i modulo
+   * numShards.
+   * @param shardIndex The shard whose values are returned by getCurrent.
    */
   SygusEnumerator(Env& env,
                   TermDbSygus* tds = nullptr,
                   SygusEnumeratorCallback* sec = nullptr,
                   SygusStatistics* s = nullptr,
                   bool enumShapes = false,
-                  bool enumAnyConstHoles = false);
+                  bool enumAnyConstHoles = false,
+                  uint64_t numShards = 1,
+                  uint64_t shardIndex = 0);
   ~SygusEnumerator() {}
   /** initialize this class with enumerator e */
   void initialize(Node e) override;
@@ -103,6 +110,10 @@ class SygusEnumerator : public EnumValGenerator
   /** Whether we are enumerating free variables as arguments to any-constant
    * constructors */
   bool d_enumAnyConstHoles;
+  /** The number of shards */
+  uint64_t d_numShards;
+  /** The shard whose values we return */
+  uint64_t d_shardIndex;
   /** Term cache
    *
    * This stores a list of terms for a given sygus type. The key features of
@@ -369,6 +380,16 @@ class SygusEnumerator : public EnumValGenerator
      * return false.
      */
     bool increment() override;
+    /**
+     * Get the index of the (size, constructor class) slice of the current
+     * term, where slices are numbered from zero in the order they are
+     * enumerated.
+     */
+    uint64_t getCurrentSlice() const
+    {
+      Assert(d_sliceNum > 0);
+      return d_sliceNum - 1;
+    }
 
    private:
     /** pointer to term database sygus */
@@ -386,6 +407,8 @@ class SygusEnumerator : public EnumValGenerator
     //----------------------------- current constructor class information
     /** the next constructor class we are using */
     unsigned d_consClassNum;
+    /** the number of slices whose enumeration we started */
+    uint64_t d_sliceNum;
     /** the constructors in the current constructor class */
     std::vector<unsigned> d_ccCons;
     /** the types of the current constructor class */
@@ -502,6 +525,8 @@ class SygusEnumerator : public EnumValGenerator
   TypeNode d_etype;
   /** pointer to the master enumerator of type d_etype */
   TermEnum* d_tlEnum;
+  /** the master enumerator of type d_etype, if it is a sygus type */
+  TermEnumMaster* d_tlMaster;
   /** the abort size, caches the value of --sygus-abort-size */
   int d_abortSize;
   /** get master enumerator for type tn */
@@ -706,8 +706,11 @@ EnumValueManager* SynthConjecture::getEnumValueManagerFor(Node e)
   Node f = d_tds->getSynthFunForEnumerator(e);
   bool hasExamples = (d_exampleInfer != nullptr && d_exampleInfer->hasExamples(f)
                       && d_exampleInfer->getNumExamples(f) != 0);
+  // Only the values of the first enumerator are split into shards, so that
+  // the shards partition the candidate solutions.
+  bool useShards = d_enumManager.empty();
   d_enumManager[e].reset(new EnumValueManager(
-      d_env, d_qstate, d_qim, d_treg, d_stats, e, hasExamples));
+      d_env, d_qstate, d_qim, d_treg, d_stats, e, hasExamples, useShards));
   EnumValueManager* eman = d_enumManager[e].get();
   // set up the examples
   if (hasExamples)
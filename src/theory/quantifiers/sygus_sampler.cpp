@@ -54,6 +54,8 @@ void SygusSampler::initialize(TypeNode tn,
   d_ftn = TypeNode::null();
   d_type_vars.clear();
   d_vars.clear();
+  d_evalProgs[0].reset(nullptr);
+  d_evalProgs[1].reset(nullptr);
   d_rvalue_cindices.clear();
   d_rvalue_null_cindices.clear();
   d_rstring_alphabet.clear();
@@ -109,6 +111,8 @@ void SygusSampler::initializeSygus(TermDbSygus* tds,
   Trace("sygus-sample") << "Register sampler for " << f << std::endl;
 
   d_vars.clear();
+  d_evalProgs[0].reset(nullptr);
+  d_evalProgs[1].reset(nullptr);
   d_type_vars.clear();
   d_var_index.clear();
   d_type_vars.clear();
@@ -477,14 +481,30 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   Assert(index < d_samples.size());
   // do beta-reductions in n first
   n = d_env.getRewriter()->rewrite(n);
-  // use efficient rewrite for substitution + rewrite
-  Node ev = d_env.evaluate(n, d_vars, d_samples[index], true);
+  // use efficient rewrite for substitution + rewrite, where n is compiled if
+  // it is not one of the last two terms we evaluated
+  Node ev = getEvaluatorProgram(n)->eval(d_samples[index]);
   Assert(!ev.isNull());
   Trace("sygus-sample-ev") << "Evaluate ( " << n << ", " << index << " ) -> ";
   Trace("sygus-sample-ev") << ev << std::endl;
   return ev;
 }
 
+EvaluatorProgram* SygusSampler::getEvaluatorProgram(Node n)
+{
+  if (d_evalProgs[0] != nullptr && d_evalProgs[0]->getTerm() == n)
+  {
+    return d_evalProgs[0].get();
+  }
+  std::swap(d_evalProgs[0], d_evalProgs[1]);
+  if (d_evalProgs[0] == nullptr || d_evalProgs[0]->getTerm() != n)
+  {
+    d_evalProgs[0].reset(
+        new EvaluatorProgram(*d_env.getEvaluator(true), n, d_vars));
+  }
+  return d_evalProgs[0].get();
+}
+
 int SygusSampler::getDiffSamplePointIndex(Node a, Node b)
 {
   for (unsigned i = 0, nsamp = d_samples.size(); i < nsamp; i++)
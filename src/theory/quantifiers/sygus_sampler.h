@@ -19,8 +19,10 @@
 #define CVC5__THEORY__QUANTIFIERS__SYGUS_SAMPLER_H
 
 #include <map>
+#include <memory>
 
 #include "smt/env_obj.h"
+#include "theory/evaluator.h"
 #include "theory/quantifiers/lazy_trie.h"
 #include "theory/quantifiers/term_enumeration.h"
 
@@ -213,6 +215,15 @@ class SygusSampler : protected EnvObj, public LazyTrieEvaluator
   std::map<TypeNode, std::map<Node, Node> > d_builtin_to_sygus;
   /** all variables we are sampling values for */
   std::vector<Node> d_vars;
+  /**
+   * The compiled programs of the last two terms that were evaluated, the most
+   * recent one first. The lazy trie evaluates a term on many sample points in
+   * a row, and the methods comparing two terms alternate between them, so
+   * this avoids traversing the terms for each sample point.
+   */
+  std::unique_ptr<EvaluatorProgram> d_evalProgs[2];
+  /** Get the compiled program for n, compiling it if necessary */
+  EvaluatorProgram* getEvaluatorProgram(Node n);
   /** type variables
    *
    * We group variables according to "type ids". Two variables have the same
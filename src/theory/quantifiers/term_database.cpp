@@ -15,6 +15,8 @@
 
 #include "theory/quantifiers/term_database.h"
 
+#include <algorithm>
+
 #include "expr/skolem_manager.h"
 #include "options/base_options.h"
 #include "options/quantifiers_options.h"
@@ -49,9 +51,13 @@ TermDb::TermDb(Env& env, QuantifiersState& qs, QuantifiersRegistry& qr)
       d_typeMap(d_termsContextUse),
       d_ops(d_termsContextUse),
       d_opMap(d_termsContextUse),
+      d_addedRound(d_termsContextUse),
+      d_mergedRound(context()),
       d_inactive_map(context())
 {
   d_consistent_ee = true;
+  d_round = 0;
+  d_presolveRound = 0;
   d_true = NodeManager::currentNM()->mkConst(true);
   d_false = NodeManager::currentNM()->mkConst(false);
   if (!options().quantifiers.termDbCd)
@@ -221,6 +227,10 @@ void TermDb::addTerm(Node n)
     return;
   }
   d_processed.insert(n);
+  if (options().quantifiers.eMatchingInc)
+  {
+    d_addedRound.insert(n, d_round);
+  }
   if (!TermUtil::hasInstConstAttr(n))
   {
     Trace("term-db-debug") << "register term : " << n << std::endl;
@@ -252,6 +262,31 @@ void TermDb::addTerm(Node n)
   }
 }
 
+void TermDb::eqNotifyMerge(TNode t1, TNode t2)
+{
+  if (options().quantifiers.eMatchingInc)
+  {
+    d_mergedRound.insert(t1, d_round);
+    d_mergedRound.insert(t2, d_round);
+  }
+}
+
+uint64_t TermDb::getModifiedRound(TNode n) const
+{
+  uint64_t res = d_presolveRound;
+  context::CDHashMap<Node, uint64_t>::const_iterator it = d_addedRound.find(n);
+  if (it != d_addedRound.end())
+  {
+    res = std::max(res, it->second);
+  }
+  it = d_mergedRound.find(n);
+  if (it != d_mergedRound.end())
+  {
+    res = std::max(res, it->second);
+  }
+  return res;
+}
+
 DbList* TermDb::getOrMkDbListForType(TypeNode tn)
 {
   TypeNodeDbListMap::iterator it = d_typeMap.find(tn);
@@ -377,9 +412,13 @@ void TermDb::computeUfTerms( TNode f ) {
       Assert(d_qstate.hasTerm(n));
       Trace("term-db-debug")
           << "  and value : " << d_qstate.getRepresentative(n) << std::endl;
-      Node at = d_func_map_trie[f].addOrGetTerm(n, d_arg_reps[n]);
+      Node at = d_func_map_sig.addOrGetTerm(n, f, d_arg_reps[n]);
       Assert(d_qstate.hasTerm(at));
       Trace("term-db-debug2") << "...add term returned " << at << std::endl;
+      if (at == n)
+      {
+        d_func_map_terms[f].push_back(n);
+      }
       if (at != n && d_qstate.areEqual(at, n))
       {
         setTermInactive(n);
@@ -581,6 +620,7 @@ void TermDb::setHasTerm( Node n ) {
 }
 
 void TermDb::presolve() {
+  d_presolveRound = d_round + 1;
   if (options().base.incrementalSolving && !options().quantifiers.termDbCd)
   {
     d_termsContext.pop();
@@ -589,8 +629,11 @@ void TermDb::presolve() {
 }
 
 bool TermDb::reset( Theory::Effort effort ){
+  d_round++;
   d_op_nonred_count.clear();
   d_arg_reps.clear();
+  d_func_map_sig.clear();
+  d_func_map_terms.clear();
   d_func_map_trie.clear();
   d_func_map_eqc_trie.clear();
   d_func_map_rel_dom.clear();
@@ -658,11 +701,22 @@ TNodeTrie* TermDb::getTermArgTrie(Node f)
   f = getOperatorRepresentative(f);
   computeUfTerms( f );
   std::map<Node, TNodeTrie>::iterator itut = d_func_map_trie.find(f);
-  if( itut!=d_func_map_trie.end() ){
+  if (itut != d_func_map_trie.end())
+  {
     return &itut->second;
-  }else{
-    return NULL;
   }
+  std::map<Node, std::vector<TNode>>::iterator itt = d_func_map_terms.find(f);
+  if (itt == d_func_map_terms.end())
+  {
+    return nullptr;
+  }
+  // build the trie from the non-congruent terms of f
+  TNodeTrie& tnt = d_func_map_trie[f];
+  for (TNode n : itt->second)
+  {
+    tnt.addTerm(n, d_arg_reps[n]);
+  }
+  return &tnt;
 }
 
 TNodeTrie* TermDb::getTermArgTrie(Node eqc, Node f)
@@ -690,19 +744,18 @@ TNodeTrie* TermDb::getTermArgTrie(Node eqc, Node f)
 TNode TermDb::getCongruentTerm( Node f, Node n ) {
   f = getOperatorRepresentative(f);
   computeUfTerms( f );
-  std::map<Node, TNodeTrie>::iterator itut = d_func_map_trie.find(f);
-  if( itut!=d_func_map_trie.end() ){
-    computeArgReps( n );
-    return itut->second.existsTerm( d_arg_reps[n] );
-  }else{
+  if (d_func_map_terms.find(f) == d_func_map_terms.end())
+  {
     return TNode::null();
   }
+  computeArgReps(n);
+  return d_func_map_sig.existsTerm(f, d_arg_reps[n]);
 }
 
 TNode TermDb::getCongruentTerm( Node f, std::vector< TNode >& args ) {
   f = getOperatorRepresentative(f);
   computeUfTerms( f );
-  return d_func_map_trie[f].existsTerm( args );
+  return d_func_map_sig.existsTerm(f, args);
 }
 
 }  // namespace quantifiers
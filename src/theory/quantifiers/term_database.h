@@ -24,6 +24,7 @@
 #include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "expr/attribute.h"
+#include "expr/node_signature_table.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_util.h"
 #include "theory/theory.h"
@@ -125,6 +126,25 @@ class TermDb : public QuantifiersUtil {
    * matched with via E-matching, and can be used in entailment tests below.
    */
   void addTerm(Node n);
+  /**
+   * Notification that the equivalence classes of t1 and t2 were merged in
+   * the master equality engine. If --e-matching-inc is enabled, this records
+   * that both classes were modified in the current round.
+   */
+  void eqNotifyMerge(TNode t1, TNode t2);
+  /**
+   * Returns the number of calls to reset so far, which identifies the current
+   * instantiation round.
+   */
+  uint64_t getRound() const { return d_round; }
+  /**
+   * Returns the last round in which n was added to this database, or in which
+   * an equivalence class with representative n was involved in a merge.
+   * Since instantiation lemmas of previous check-sat calls may have been
+   * popped, this is at least the first round after the last call to presolve.
+   * Only tracked if --e-matching-inc is enabled.
+   */
+  uint64_t getModifiedRound(TNode n) const;
   /** Get the currently added ground terms of the given type */
   DbList* getOrMkDbListForType(TypeNode tn);
   /** Get the currently added ground terms for the given operator */
@@ -232,6 +252,21 @@ class TermDb : public QuantifiersUtil {
   std::map< Node, std::map< TypeNode, Node > > d_par_op_map;
   /** whether master equality engine is UF-inconsistent */
   bool d_consistent_ee;
+  /** The number of calls to reset */
+  uint64_t d_round;
+  /**
+   * Map from terms to the round in which they were added. This depends on the
+   * same context as the terms of this database.
+   */
+  context::CDHashMap<Node, uint64_t> d_addedRound;
+  /**
+   * Map from representatives to the round in which they were last involved
+   * in a merge. This depends on the SAT context, such that merges of branches
+   * that were backtracked are forgotten.
+   */
+  context::CDHashMap<Node, uint64_t> d_mergedRound;
+  /** The first round after the last call to presolve */
+  uint64_t d_presolveRound;
   /** boolean terms */
   Node d_true;
   Node d_false;
@@ -243,7 +278,18 @@ class TermDb : public QuantifiersUtil {
   std::map< Node, int > d_op_nonred_count;
   /** mapping from terms to representatives of their arguments */
   std::map< TNode, std::vector< TNode > > d_arg_reps;
-  /** map from operators to trie */
+  /**
+   * Signature table over all operators, used for detecting congruent terms.
+   * The signature of a term is its operator representative together with
+   * d_arg_reps.
+   */
+  TNodeSignatureTable d_func_map_sig;
+  /** map from operators to their non-congruent terms in d_func_map_sig */
+  std::map<Node, std::vector<TNode>> d_func_map_terms;
+  /**
+   * Map from operators to trie, built on demand from d_func_map_terms when
+   * the terms of an operator are traversed by their arguments.
+   */
   std::map<Node, TNodeTrie> d_func_map_trie;
   std::map<Node, TNodeTrie> d_func_map_eqc_trie;
   /** mapping from operators to their representative relevant domains */
@@ -290,7 +336,7 @@ class TermDb : public QuantifiersUtil {
   */
   void computeUfEqcTerms( TNode f );
   /** compute uf terms
-  * Ensure that an entry for f is in d_func_map_trie
+  * Ensure that the terms of f are in d_func_map_sig and d_func_map_terms
   */
   void computeUfTerms( TNode f );
   /** compute arg reps
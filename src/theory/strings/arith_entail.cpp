@@ -19,6 +19,7 @@
 #include "expr/node_algorithm.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/rewriter.h"
+#include "theory/strings/sequences_stats.h"
 #include "theory/strings/theory_strings_utils.h"
 #include "theory/strings/word.h"
 #include "theory/theory.h"
@@ -30,7 +31,8 @@ namespace cvc5 {
 namespace theory {
 namespace strings {
 
-ArithEntail::ArithEntail(Rewriter* r) : d_rr(r)
+ArithEntail::ArithEntail(Rewriter* r, SequencesStatistics* statistics)
+    : d_rr(r), d_statistics(statistics)
 {
   d_zero = NodeManager::currentNM()->mkConstInt(Rational(0));
 }
@@ -54,8 +56,45 @@ bool ArithEntail::check(Node a, Node b, bool strict)
   {
     return !strict;
   }
+  bool ret;
+  if (getCheckCache(a, b, strict, ret))
+  {
+    return ret;
+  }
   Node diff = NodeManager::currentNM()->mkNode(kind::MINUS, a, b);
-  return check(diff, strict);
+  ret = checkRewritten(diff, strict);
+  setCheckCache(a, b, strict, ret);
+  return ret;
+}
+
+bool ArithEntail::getCheckCache(Node a, Node b, bool strict, bool& res)
+{
+  const auto& cache = d_checkCache[strict ? 1 : 0];
+  auto it = cache.find(std::make_pair(a, b));
+  if (it == cache.end())
+  {
+    if (d_statistics != nullptr)
+    {
+      ++d_statistics->d_entailCacheMisses;
+    }
+    return false;
+  }
+  if (d_statistics != nullptr)
+  {
+    ++d_statistics->d_entailCacheHits;
+  }
+  res = it->second;
+  return true;
+}
+
+void ArithEntail::setCheckCache(Node a, Node b, bool strict, bool res)
+{
+  auto& cache = d_checkCache[strict ? 1 : 0];
+  if (cache.size() >= s_maxCheckCacheSize)
+  {
+    cache.clear();
+  }
+  cache[std::make_pair(a, b)] = res;
 }
 
 struct StrCheckEntailArithTag
@@ -75,7 +114,18 @@ bool ArithEntail::check(Node a, bool strict)
   {
     return a.getConst<Rational>().sgn() >= (strict ? 1 : 0);
   }
+  bool ret;
+  if (getCheckCache(a, Node::null(), strict, ret))
+  {
+    return ret;
+  }
+  ret = checkRewritten(a, strict);
+  setCheckCache(a, Node::null(), strict, ret);
+  return ret;
+}
 
+bool ArithEntail::checkRewritten(Node a, bool strict)
+{
   Node ar =
       strict ? NodeManager::currentNM()->mkNode(
           kind::MINUS, a, NodeManager::currentNM()->mkConstInt(Rational(1)))
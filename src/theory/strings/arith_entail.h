@@ -18,9 +18,11 @@
 #ifndef CVC5__THEORY__STRINGS__ARITH_ENTAIL_H
 #define CVC5__THEORY__STRINGS__ARITH_ENTAIL_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "expr/node.h"
+#include "util/hash.h"
 
 namespace cvc5 {
 namespace theory {
@@ -29,6 +31,8 @@ class Rewriter;
 
 namespace strings {
 
+class SequencesStatistics;
+
 /**
  * Techniques for computing arithmetic entailment for string terms. This
  * is an implementation of the techniques from Reynolds et al, "High Level
@@ -37,7 +41,7 @@ namespace strings {
 class ArithEntail
 {
  public:
-  ArithEntail(Rewriter* r);
+  ArithEntail(Rewriter* r, SequencesStatistics* statistics = nullptr);
   /**
    * Returns the rewritten form a term, intended (although not enforced) to be
    * an arithmetic term.
@@ -174,6 +178,12 @@ class ArithEntail
    * a is in rewritten form.
    */
   bool checkInternal(Node a);
+  /**
+   * Returns true if a >= 0 (resp. a > 0 if strict is true) is entailed, where
+   * a is not necessarily in rewritten form. The result is cached on the
+   * rewritten form of a (resp. a - 1).
+   */
+  bool checkRewritten(Node a, bool strict);
   /** Get arithmetic approximations
    *
    * This gets the (set of) arithmetic approximations for term a and stores
@@ -199,8 +209,30 @@ class ArithEntail
    * computed. Used for getConstantBound and getConstantBoundLength.
    */
   static bool getConstantBoundCache(TNode n, bool isLower, Node& c);
+  /**
+   * Lookup the result of check(a, b, strict) in the entailment cache, where
+   * b is null for check(a, strict). Returns true and sets res if it is cached.
+   */
+  bool getCheckCache(Node a, Node b, bool strict, bool& res);
+  /** Cache res as the result of check(a, b, strict) */
+  void setCheckCache(Node a, Node b, bool strict, bool res);
   /** The underlying rewriter */
   Rewriter* d_rr;
+  /** Pointer to the statistics (if any) */
+  SequencesStatistics* d_statistics;
+  /**
+   * The entailment cache for check, for non-strict and strict entailments.
+   * The results of check are additionally cached on the rewritten form of
+   * a - b (resp. a - b - 1) using attributes. This cache avoids constructing
+   * and rewriting the difference for repeated calls with the same arguments.
+   * It is cleared when it reaches s_maxCheckCacheSize entries.
+   */
+  std::unordered_map<std::pair<Node, Node>,
+                     bool,
+                     PairHashFunction<Node, Node, std::hash<Node>>>
+      d_checkCache[2];
+  /** The maximal number of entries in each check cache */
+  static constexpr size_t s_maxCheckCacheSize = 1 << 14;
   /** Constant zero */
   Node d_zero;
 };
@@ -42,7 +42,8 @@ ArrayCoreSolver::ArrayCoreSolver(Env& env,
       d_esolver(es),
       d_extt(extt),
       d_lem(context()),
-      d_registeredUpdates(userContext())
+      d_registeredUpdates(userContext()),
+      d_nthUpdateProc(context())
 {
 }
 
@@ -81,18 +82,26 @@ void ArrayCoreSolver::checkNth(const std::vector<Node>& nthTerms)
       sendInference(exp, lem, InferenceId::STRINGS_ARRAY_NTH_EXTRACT);
     }
   }
-  for (size_t i = 0; i < nthTerms.size(); i++)
+  // group the nth terms by the equivalence class of their index, since only
+  // nth terms with equal indices are split on
+  std::map<Node, std::vector<Node>> nthByIndex;
+  for (const Node& t : nthTerms)
   {
-    for (size_t j = i + 1; j < nthTerms.size(); j++)
+    nthByIndex[d_state.getRepresentative(t[1])].push_back(t);
+  }
+  for (const std::pair<const Node, std::vector<Node>>& ni : nthByIndex)
+  {
+    const std::vector<Node>& terms = ni.second;
+    for (size_t i = 0, nterms = terms.size(); i < nterms; i++)
     {
-      Node x = nthTerms[i][0];
-      Node y = nthTerms[j][0];
-      Node n = nthTerms[i][1];
-      Node m = nthTerms[j][1];
-      if (d_state.areEqual(n, m) && !d_state.areEqual(x, y)
-          && !d_state.areDisequal(x, y))
+      for (size_t j = i + 1; j < nterms; j++)
       {
-        d_im.sendSplit(x, y, InferenceId::STRINGS_ARRAY_EQ_SPLIT);
+        Node x = terms[i][0];
+        Node y = terms[j][0];
+        if (!d_state.areEqual(x, y) && !d_state.areDisequal(x, y))
+        {
+          d_im.sendSplit(x, y, InferenceId::STRINGS_ARRAY_EQ_SPLIT);
+        }
       }
     }
   }
@@ -153,22 +162,37 @@ void ArrayCoreSolver::checkUpdate(const std::vector<Node>& updateTerms)
           exp, lem, InferenceId::STRINGS_ARRAY_UPDATE_BOUND, false, true);
     }
 
-    for (const auto& nthIdxs : d_indexMap)
+    // Enumerate n-th terms for sequences that are related to the current
+    // update term, which are the ones in the equivalence class of the update
+    // term or of the updated sequence. Since d_indexMap is indexed by
+    // representatives, we look them up directly.
+    Node seqs[2] = {d_state.getRepresentative(n),
+                    d_state.getRepresentative(n[0])};
+    for (size_t s = 0; s < 2; s++)
     {
-      // Enumerate n-th terms for sequences that are related to the current
-      // update term
-      Node seq = nthIdxs.first;
-      if (!d_state.areEqual(seq, n) && !d_state.areEqual(seq, n[0]))
+      if (s == 1 && seqs[1] == seqs[0])
+      {
+        break;
+      }
+      std::map<Node, std::set<Node>>::const_iterator itIdx =
+          d_indexMap.find(seqs[s]);
+      if (itIdx == d_indexMap.end())
       {
         continue;
       }
-
-      const std::set<Node>& indexes = nthIdxs.second;
-      Trace("seq-array-core-debug") << "  check nth for " << seq
+      const std::set<Node>& indexes = itIdx->second;
+      Trace("seq-array-core-debug") << "  check nth for " << seqs[s]
                                     << " with indices " << indexes << std::endl;
       Node i = n[1];
       for (Node j : indexes)
       {
+        if (d_nthUpdateProc.find(std::make_pair(n, j))
+            != d_nthUpdateProc.end())
+        {
+          // already sent in this context
+          continue;
+        }
+        d_nthUpdateProc.insert(std::make_pair(n, j));
         // nth(update(s, n, t), m)
         // ------------------------
         // nth(update(s, n, t)) =
@@ -18,6 +18,7 @@
 #ifndef CVC5__THEORY__STRINGS__ARRAY_CORE_SOLVER_H
 #define CVC5__THEORY__STRINGS__ARRAY_CORE_SOLVER_H
 
+#include "context/cdhashset.h"
 #include "theory/strings/core_solver.h"
 #include "theory/strings/extf_solver.h"
 #include "theory/strings/inference_manager.h"
@@ -135,9 +136,20 @@ class ArrayCoreSolver : protected EnvObj
   context::CDHashSet<Node> d_lem;
   /** Set of updates that have been registered */
   context::CDHashSet<Node> d_registeredUpdates;
+  /**
+   * Set of pairs (update term, index) for which we have sent the lemma for
+   * the nth term of the update at the index in the current context.
+   */
+  context::CDHashSet<std::pair<Node, Node>,
+                     PairHashFunction<Node, Node, std::hash<Node>>>
+      d_nthUpdateProc;
 
   // ========= data structure =========
-  /** Map sequence variable to indices that occurred in nth terms */
+  /**
+   * Map from sequence equivalence classes to the indices that occur in nth
+   * terms of a sequence in the equivalence class, computed at the beginning
+   * of check.
+   */
   std::map<Node, std::set<Node>> d_indexMap;
 };
 
@@ -0,0 +1,539 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of automata for constant regular expressions.
+ */
+
+#include "theory/strings/regexp_automaton.h"
+
+#include <algorithm>
+
+#include "theory/strings/theory_strings_utils.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+RegExpAutomaton::RegExpAutomaton(uint32_t lastChar)
+    : d_lastChar(lastChar), d_start(0), d_final(0)
+{
+}
+
+std::unique_ptr<RegExpAutomaton> RegExpAutomaton::compile(Node r,
+                                                          uint32_t lastChar)
+{
+  std::unique_ptr<RegExpAutomaton> a(new RegExpAutomaton(lastChar));
+  if (!a->build(r, a->d_start, a->d_final))
+  {
+    return nullptr;
+  }
+  // make the initial deterministic state
+  std::vector<uint32_t> init{a->d_start};
+  a->getDfaState(init);
+  Assert(a->d_dfa.size() == 1);
+  return a;
+}
+
+uint32_t RegExpAutomaton::addState()
+{
+  d_eps.emplace_back();
+  d_trans.emplace_back();
+  return static_cast<uint32_t>(d_eps.size() - 1);
+}
+
+bool RegExpAutomaton::build(Node r, uint32_t& start, uint32_t& end)
+{
+  if (d_eps.size() > s_maxNfaStates)
+  {
+    return false;
+  }
+  Kind k = r.getKind();
+  switch (k)
+  {
+    case REGEXP_NONE:
+    {
+      start = addState();
+      end = addState();
+      return true;
+    }
+    case REGEXP_ALLCHAR:
+    {
+      start = addState();
+      end = addState();
+      d_trans[start].push_back(Transition{0, d_lastChar, end});
+      return true;
+    }
+    case REGEXP_RANGE:
+    {
+      if (!r[0].isConst() || !r[1].isConst()
+          || r[0].getConst<String>().size() != 1
+          || r[1].getConst<String>().size() != 1)
+      {
+        return false;
+      }
+      uint32_t lo = r[0].getConst<String>().front();
+      uint32_t hi = r[1].getConst<String>().front();
+      start = addState();
+      end = addState();
+      if (lo <= hi)
+      {
+        d_trans[start].push_back(Transition{lo, hi, end});
+      }
+      return true;
+    }
+    case STRING_TO_REGEXP:
+    {
+      if (!r[0].isConst())
+      {
+        return false;
+      }
+      start = addState();
+      end = start;
+      for (unsigned c : r[0].getConst<String>().getVec())
+      {
+        uint32_t next = addState();
+        d_trans[end].push_back(Transition{c, c, next});
+        end = next;
+      }
+      return true;
+    }
+    case REGEXP_CONCAT:
+    {
+      for (size_t i = 0, nchild = r.getNumChildren(); i < nchild; i++)
+      {
+        uint32_t cstart, cend;
+        if (!build(r[i], cstart, cend))
+        {
+          return false;
+        }
+        if (i == 0)
+        {
+          start = cstart;
+        }
+        else
+        {
+          d_eps[end].push_back(cstart);
+        }
+        end = cend;
+      }
+      return true;
+    }
+    case REGEXP_UNION:
+    {
+      start = addState();
+      end = addState();
+      for (const Node& rc : r)
+      {
+        uint32_t cstart, cend;
+        if (!build(rc, cstart, cend))
+        {
+          return false;
+        }
+        d_eps[start].push_back(cstart);
+        d_eps[cend].push_back(end);
+      }
+      return true;
+    }
+    case REGEXP_STAR:
+    case REGEXP_PLUS:
+    case REGEXP_OPT:
+    {
+      uint32_t cstart, cend;
+      if (!build(r[0], cstart, cend))
+      {
+        return false;
+      }
+      start = addState();
+      end = addState();
+      d_eps[start].push_back(cstart);
+      d_eps[cend].push_back(end);
+      if (k != REGEXP_OPT)
+      {
+        d_eps[cend].push_back(cstart);
+      }
+      if (k != REGEXP_PLUS)
+      {
+        d_eps[start].push_back(end);
+      }
+      return true;
+    }
+    case REGEXP_REPEAT:
+    case REGEXP_LOOP:
+    {
+      // the first nmin copies of r[0] are required, the next (nmax - nmin)
+      // copies are optional
+      unsigned nmin, nmax;
+      if (k == REGEXP_REPEAT)
+      {
+        nmin = utils::getRepeatAmount(r);
+        nmax = nmin;
+      }
+      else
+      {
+        nmin = utils::getLoopMinOccurrences(r);
+        nmax = utils::getLoopMaxOccurrences(r);
+      }
+      start = addState();
+      end = addState();
+      uint32_t cur = start;
+      for (unsigned i = 0; i < nmax; i++)
+      {
+        uint32_t cstart, cend;
+        if (!build(r[0], cstart, cend))
+        {
+          return false;
+        }
+        if (i >= nmin)
+        {
+          d_eps[cur].push_back(end);
+        }
+        d_eps[cur].push_back(cstart);
+        cur = cend;
+      }
+      d_eps[cur].push_back(end);
+      return true;
+    }
+    case REGEXP_INTER:
+    case REGEXP_DIFF:
+    case REGEXP_COMPLEMENT: return buildProduct(r, start, end);
+    default:
+      // variables or internal operators
+      return false;
+  }
+}
+
+bool RegExpAutomaton::buildProduct(Node r, uint32_t& start, uint32_t& end)
+{
+  Kind k = r.getKind();
+  std::vector<std::unique_ptr<RegExpAutomaton>> children;
+  std::vector<RegExpAutomaton*> as;
+  std::vector<bool> pols;
+  for (size_t i = 0, nchild = r.getNumChildren(); i < nchild; i++)
+  {
+    children.push_back(compile(r[i], d_lastChar));
+    if (children.back() == nullptr)
+    {
+      return false;
+    }
+    as.push_back(children.back().get());
+    pols.push_back(k == REGEXP_INTER || (k == REGEXP_DIFF && i == 0));
+  }
+  std::vector<ProductState> product;
+  if (!mkProduct(as, pols, d_lastChar, false, product)
+      || d_eps.size() + product.size() > s_maxNfaStates)
+  {
+    return false;
+  }
+  // embed the product automaton
+  uint32_t base = static_cast<uint32_t>(d_eps.size());
+  for (size_t i = 0, nstates = product.size(); i < nstates; i++)
+  {
+    addState();
+  }
+  start = addState();
+  end = addState();
+  d_eps[start].push_back(base);
+  for (size_t i = 0, nstates = product.size(); i < nstates; i++)
+  {
+    if (product[i].d_accepting)
+    {
+      d_eps[base + i].push_back(end);
+    }
+    for (const Transition& t : product[i].d_trans)
+    {
+      d_trans[base + i].push_back(
+          Transition{t.d_lo, t.d_hi, base + t.d_target});
+    }
+  }
+  return true;
+}
+
+uint32_t RegExpAutomaton::getDfaState(std::vector<uint32_t>& nfaStates)
+{
+  // compute the epsilon closure
+  std::vector<bool> visited(d_eps.size(), false);
+  std::vector<uint32_t> closure;
+  while (!nfaStates.empty())
+  {
+    uint32_t cur = nfaStates.back();
+    nfaStates.pop_back();
+    if (visited[cur])
+    {
+      continue;
+    }
+    visited[cur] = true;
+    closure.push_back(cur);
+    nfaStates.insert(nfaStates.end(), d_eps[cur].begin(), d_eps[cur].end());
+  }
+  if (closure.empty())
+  {
+    return s_dead;
+  }
+  std::sort(closure.begin(), closure.end());
+  std::map<std::vector<uint32_t>, uint32_t>::iterator it =
+      d_dfaIds.find(closure);
+  if (it != d_dfaIds.end())
+  {
+    return it->second;
+  }
+  uint32_t d = static_cast<uint32_t>(d_dfa.size());
+  d_dfaIds[closure] = d;
+  d_dfa.push_back(DfaState{std::move(closure), visited[d_final], false, {}});
+  return d;
+}
+
+const std::vector<RegExpAutomaton::Transition>&
+RegExpAutomaton::getTransitions(uint32_t d)
+{
+  Assert(d < d_dfa.size());
+  if (d_dfa[d].d_expanded)
+  {
+    return d_dfa[d].d_trans;
+  }
+  // copy, since computing successors may add deterministic states
+  std::vector<uint32_t> nfaStates = d_dfa[d].d_nfaStates;
+  // split the alphabet into the ranges on which all transitions agree
+  std::vector<uint32_t> cuts;
+  for (uint32_t s : nfaStates)
+  {
+    for (const Transition& t : d_trans[s])
+    {
+      cuts.push_back(t.d_lo);
+      cuts.push_back(t.d_hi + 1);
+    }
+  }
+  std::sort(cuts.begin(), cuts.end());
+  cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+  std::vector<Transition> trans;
+  std::vector<uint32_t> targets;
+  for (size_t i = 0; i + 1 < cuts.size(); i++)
+  {
+    uint32_t lo = cuts[i];
+    uint32_t hi = cuts[i + 1] - 1;
+    targets.clear();
+    for (uint32_t s : nfaStates)
+    {
+      for (const Transition& t : d_trans[s])
+      {
+        if (t.d_lo <= lo && hi <= t.d_hi)
+        {
+          targets.push_back(t.d_target);
+        }
+      }
+    }
+    if (targets.empty())
+    {
+      continue;
+    }
+    uint32_t target = getDfaState(targets);
+    if (!trans.empty() && trans.back().d_target == target
+        && trans.back().d_hi + 1 == lo)
+    {
+      trans.back().d_hi = hi;
+    }
+    else
+    {
+      trans.push_back(Transition{lo, hi, target});
+    }
+  }
+  d_dfa[d].d_trans = std::move(trans);
+  d_dfa[d].d_expanded = true;
+  return d_dfa[d].d_trans;
+}
+
+uint32_t RegExpAutomaton::getSuccessor(uint32_t d, uint32_t c)
+{
+  if (d == s_dead)
+  {
+    return s_dead;
+  }
+  const std::vector<Transition>& trans = getTransitions(d);
+  // find the first transition whose range starts after c
+  std::vector<Transition>::const_iterator it = std::upper_bound(
+      trans.begin(), trans.end(), c, [](uint32_t cc, const Transition& t) {
+        return cc < t.d_lo;
+      });
+  if (it == trans.begin())
+  {
+    return s_dead;
+  }
+  --it;
+  return c <= it->d_hi ? it->d_target : s_dead;
+}
+
+bool RegExpAutomaton::isAccepting(uint32_t d) const
+{
+  return d != s_dead && d_dfa[d].d_accepting;
+}
+
+bool RegExpAutomaton::accepts(const String& s)
+{
+  uint32_t d = 0;
+  for (size_t i = 0, size = s.size(); i < size; i++)
+  {
+    d = getSuccessor(d, s[i]);
+    if (d == s_dead)
+    {
+      return false;
+    }
+  }
+  return isAccepting(d);
+}
+
+bool RegExpAutomaton::mkProduct(const std::vector<RegExpAutomaton*>& as,
+                                const std::vector<bool>& pols,
+                                uint32_t lastChar,
+                                bool stopAtAccepting,
+                                std::vector<ProductState>& product)
+{
+  Assert(as.size() == pols.size());
+  size_t n = as.size();
+  // the product states, which are tuples of deterministic states
+  std::map<std::vector<uint32_t>, uint32_t> ids;
+  std::vector<std::vector<uint32_t>> tuples;
+  std::vector<uint32_t> init(n, 0);
+  bool accepting = true;
+  for (size_t j = 0; j < n; j++)
+  {
+    accepting = accepting && as[j]->isAccepting(0) == pols[j];
+  }
+  ids[init] = 0;
+  tuples.push_back(init);
+  product.clear();
+  product.push_back(ProductState{accepting, {}});
+  std::vector<uint32_t> cuts;
+  std::vector<uint32_t> succ(n);
+  for (size_t i = 0; i < tuples.size(); i++)
+  {
+    if (stopAtAccepting && accepting)
+    {
+      return true;
+    }
+    std::vector<uint32_t> tuple = tuples[i];
+    // split the alphabet into the ranges on which all components agree
+    cuts.clear();
+    cuts.push_back(0);
+    cuts.push_back(lastChar + 1);
+    for (size_t j = 0; j < n; j++)
+    {
+      if (tuple[j] == s_dead)
+      {
+        continue;
+      }
+      for (const Transition& t : as[j]->getTransitions(tuple[j]))
+      {
+        cuts.push_back(std::min(t.d_lo, lastChar + 1));
+        cuts.push_back(std::min(t.d_hi + 1, lastChar + 1));
+      }
+    }
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+    for (size_t k = 0; k + 1 < cuts.size(); k++)
+    {
+      uint32_t lo = cuts[k];
+      uint32_t hi = cuts[k + 1] - 1;
+      bool isDead = false;
+      for (size_t j = 0; j < n && !isDead; j++)
+      {
+        succ[j] = as[j]->getSuccessor(tuple[j], lo);
+        // a string rejected by a component with positive polarity cannot be
+        // accepted by the product
+        isDead = succ[j] == s_dead && pols[j];
+      }
+      if (isDead)
+      {
+        continue;
+      }
+      uint32_t target;
+      std::map<std::vector<uint32_t>, uint32_t>::iterator it = ids.find(succ);
+      if (it != ids.end())
+      {
+        target = it->second;
+      }
+      else
+      {
+        if (product.size() >= s_maxProductStates)
+        {
+          return false;
+        }
+        target = static_cast<uint32_t>(product.size());
+        ids[succ] = target;
+        tuples.push_back(succ);
+        bool tAccepting = true;
+        for (size_t j = 0; j < n; j++)
+        {
+          tAccepting = tAccepting && as[j]->isAccepting(succ[j]) == pols[j];
+        }
+        accepting = accepting || tAccepting;
+        product.push_back(ProductState{tAccepting, {}});
+      }
+      std::vector<Transition>& trans = product[i].d_trans;
+      if (!trans.empty() && trans.back().d_target == target
+          && trans.back().d_hi + 1 == lo)
+      {
+        trans.back().d_hi = hi;
+      }
+      else
+      {
+        trans.push_back(Transition{lo, hi, target});
+      }
+    }
+  }
+  return true;
+}
+
+std::optional<bool> RegExpAutomaton::isProductNonEmpty(
+    const std::vector<RegExpAutomaton*>& as, const std::vector<bool>& pols)
+{
+  std::vector<ProductState> product;
+  if (!mkProduct(as, pols, as[0]->d_lastChar, true, product))
+  {
+    return std::nullopt;
+  }
+  for (const ProductState& ps : product)
+  {
+    if (ps.d_accepting)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<bool> RegExpAutomaton::isIntersectionEmpty(RegExpAutomaton& a1,
+                                                         RegExpAutomaton& a2)
+{
+  std::optional<bool> res = isProductNonEmpty({&a1, &a2}, {true, true});
+  if (!res)
+  {
+    return std::nullopt;
+  }
+  return !*res;
+}
+
+std::optional<bool> RegExpAutomaton::includes(RegExpAutomaton& a1,
+                                              RegExpAutomaton& a2)
+{
+  // a1 includes a2 iff no string is accepted by a2 and rejected by a1
+  std::optional<bool> res = isProductNonEmpty({&a2, &a1}, {true, false});
+  if (!res)
+  {
+    return std::nullopt;
+  }
+  return !*res;
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Automata for constant regular expressions.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__STRINGS__REGEXP_AUTOMATON_H
+#define CVC5__THEORY__STRINGS__REGEXP_AUTOMATON_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+/**
+ * An automaton for a constant regular expression.
+ *
+ * The regular expression is compiled into a nondeterministic automaton
+ * (Thompson's construction), whose transitions are labeled by ranges of
+ * code points, so that the size of the automaton does not depend on the size
+ * of the alphabet. The automaton is determinized lazily by the subset
+ * construction: a deterministic state and its transitions are only computed
+ * when they are reached by a membership test or a product construction, and
+ * are kept for later queries. The transitions of a deterministic state
+ * partition the alphabet into ranges that are treated alike by all of its
+ * nondeterministic states, characters without a transition lead to the
+ * (implicit) dead state.
+ *
+ * Intersection, difference and complement are compiled by determinizing the
+ * product of the automata for their children and embedding it into the
+ * nondeterministic automaton. Products are also used to answer emptiness,
+ * intersection and inclusion queries. Since determinization may be
+ * exponential, products are limited to a fixed number of states, in which
+ * case compilation fails or the query returns no answer.
+ */
+class RegExpAutomaton
+{
+ public:
+  /**
+   * Compile the regular expression r over the alphabet of code points
+   * 0, ..., lastChar. Returns null if r contains variables or operators that
+   * are not supported, or if it is too large.
+   */
+  static std::unique_ptr<RegExpAutomaton> compile(Node r, uint32_t lastChar);
+  /** Does this automaton accept s? */
+  bool accepts(const String& s);
+  /**
+   * Returns true if the languages of a1 and a2 are disjoint, false if they
+   * are not, and no value if the product of a1 and a2 is too large.
+   */
+  static std::optional<bool> isIntersectionEmpty(RegExpAutomaton& a1,
+                                                 RegExpAutomaton& a2);
+  /**
+   * Returns true if the language of a1 includes the language of a2, false if
+   * it does not, and no value if the product of a1 and a2 is too large.
+   */
+  static std::optional<bool> includes(RegExpAutomaton& a1,
+                                      RegExpAutomaton& a2);
+  /** Get the number of states of the nondeterministic automaton */
+  size_t getNumNfaStates() const { return d_eps.size(); }
+  /** Get the number of deterministic states computed so far */
+  size_t getNumDfaStates() const { return d_dfa.size(); }
+
+ private:
+  /** A transition on the characters d_lo, ..., d_hi */
+  struct Transition
+  {
+    uint32_t d_lo;
+    uint32_t d_hi;
+    uint32_t d_target;
+  };
+  /** A state of the deterministic automaton */
+  struct DfaState
+  {
+    /** The (epsilon-closed, sorted) set of nondeterministic states */
+    std::vector<uint32_t> d_nfaStates;
+    /** Whether this state is accepting */
+    bool d_accepting;
+    /** Whether d_trans has been computed */
+    bool d_expanded;
+    /** The transitions, sorted by their ranges */
+    std::vector<Transition> d_trans;
+  };
+  /** A state of a product automaton, with transitions to product states */
+  struct ProductState
+  {
+    bool d_accepting;
+    std::vector<Transition> d_trans;
+  };
+  /** The dead state of deterministic automata */
+  static constexpr uint32_t s_dead = static_cast<uint32_t>(-1);
+  /** The maximal number of nondeterministic states */
+  static constexpr size_t s_maxNfaStates = 1 << 16;
+  /** The maximal number of states of a product automaton */
+  static constexpr size_t s_maxProductStates = 1 << 12;
+
+  RegExpAutomaton(uint32_t lastChar);
+  /** Add a new nondeterministic state, return its index */
+  uint32_t addState();
+  /**
+   * Add states recognizing r, where start and end are set to the initial
+   * and final state. Returns false if r cannot be compiled.
+   */
+  bool build(Node r, uint32_t& start, uint32_t& end);
+  /**
+   * Add the states of the product of the automata for the children of r
+   * (see mkProduct), where the polarity of a child is false if it is
+   * complemented by r.
+   */
+  bool buildProduct(Node r, uint32_t& start, uint32_t& end);
+  /**
+   * Get the deterministic state for the epsilon-closure of the given
+   * nondeterministic states, or s_dead if it is empty.
+   */
+  uint32_t getDfaState(std::vector<uint32_t>& nfaStates);
+  /** Get the transitions of the deterministic state d */
+  const std::vector<Transition>& getTransitions(uint32_t d);
+  /** Get the successor of the deterministic state d for character c */
+  uint32_t getSuccessor(uint32_t d, uint32_t c);
+  /** Is the deterministic state d accepting? */
+  bool isAccepting(uint32_t d) const;
+  /**
+   * Computes the reachable part of the deterministic automaton recognizing
+   * the strings that are accepted by each automaton in as whose polarity in
+   * pols is true and rejected by each automaton whose polarity is false.
+   * The first product state is the initial one. If stopAtAccepting is true,
+   * we stop as soon as an accepting product state was added. Returns false
+   * if the product exceeds s_maxProductStates.
+   */
+  static bool mkProduct(const std::vector<RegExpAutomaton*>& as,
+                        const std::vector<bool>& pols,
+                        uint32_t lastChar,
+                        bool stopAtAccepting,
+                        std::vector<ProductState>& product);
+  /** Is there an accepting state in the product of as with pols? */
+  static std::optional<bool> isProductNonEmpty(
+      const std::vector<RegExpAutomaton*>& as, const std::vector<bool>& pols);
+  /** The code point of the last character of the alphabet */
+  uint32_t d_lastChar;
+  /** The epsilon transitions of each nondeterministic state */
+  std::vector<std::vector<uint32_t>> d_eps;
+  /** The character transitions of each nondeterministic state */
+  std::vector<std::vector<Transition>> d_trans;
+  /** The initial nondeterministic state */
+  uint32_t d_start;
+  /** The (unique) final nondeterministic state */
+  uint32_t d_final;
+  /** The deterministic states computed so far, the first one is initial */
+  std::vector<DfaState> d_dfa;
+  /** Map from sets of nondeterministic states to deterministic states */
+  std::map<std::vector<uint32_t>, uint32_t> d_dfaIds;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__STRINGS__REGEXP_AUTOMATON_H */
@@ -20,10 +20,12 @@
 #include "expr/node_algorithm.h"
 #include "options/strings_options.h"
 #include "theory/rewriter.h"
+#include "theory/strings/regexp_automaton.h"
 #include "theory/strings/regexp_entail.h"
 #include "theory/strings/theory_strings_utils.h"
 #include "theory/strings/word.h"
 #include "util/regexp.h"
+#include "util/statistics_registry.h"
 
 using namespace cvc5::kind;
 
@@ -43,7 +45,11 @@ RegExpOpr::RegExpOpr(Env& env, SkolemCache* sc)
                                                std::vector<Node>{})),
       d_sigma_star(
           NodeManager::currentNM()->mkNode(kind::REGEXP_STAR, d_sigma)),
-      d_sc(sc)
+      d_sc(sc),
+      d_automataCompiled(statisticsRegistry().registerInt(
+          "theory::strings::regexp::automataCompiled")),
+      d_automataQueries(statisticsRegistry().registerInt(
+          "theory::strings::regexp::automataQueries"))
 {
   d_emptyString = Word::mkEmptyWord(NodeManager::currentNM()->stringType());
 
@@ -1438,6 +1444,21 @@ Node RegExpOpr::intersect(Node r1, Node r2)
   {
     return Node::null();
   }
+  RegExpAutomaton* a1 = getAutomaton(r1);
+  RegExpAutomaton* a2 = a1 == nullptr ? nullptr : getAutomaton(r2);
+  if (a2 != nullptr)
+  {
+    std::optional<bool> isEmpty =
+        RegExpAutomaton::isIntersectionEmpty(*a1, *a2);
+    if (isEmpty && *isEmpty)
+    {
+      ++d_automataQueries;
+      Trace("regexp-intersect") << "INTERSECTION(\n\t" << mkString(r1)
+                                << ",\n\t" << mkString(r2)
+                                << ") is empty by automata" << std::endl;
+      return d_emptyRegexp;
+    }
+  }
   Node rr1 = removeIntersection(r1);
   Node rr2 = removeIntersection(r2);
   std::map<PairNodes, Node> cache;
@@ -1582,10 +1603,60 @@ bool RegExpOpr::regExpIncludes(Node r1, Node r2)
     return (*it).second;
   }
   bool result = RegExpEntail::regExpIncludes(r1, r2);
+  if (!result)
+  {
+    // the syntactic check is incomplete, try the automata if available
+    RegExpAutomaton* a1 = getAutomaton(r1);
+    RegExpAutomaton* a2 = a1 == nullptr ? nullptr : getAutomaton(r2);
+    if (a2 != nullptr)
+    {
+      std::optional<bool> incl = RegExpAutomaton::includes(*a1, *a2);
+      if (incl)
+      {
+        ++d_automataQueries;
+        result = *incl;
+      }
+    }
+  }
   d_inclusionCache[std::make_pair(r1, r2)] = result;
   return result;
 }
 
+Node RegExpOpr::testConstMembership(const String& s, Node r)
+{
+  RegExpAutomaton* a = getAutomaton(r);
+  if (a == nullptr)
+  {
+    return Node::null();
+  }
+  ++d_automataQueries;
+  return a->accepts(s) ? d_true : d_false;
+}
+
+RegExpAutomaton* RegExpOpr::getAutomaton(Node r)
+{
+  if (!options().strings.stringRegExpAutomata)
+  {
+    return nullptr;
+  }
+  std::unordered_map<Node, std::unique_ptr<RegExpAutomaton>>::iterator it =
+      d_automata.find(r);
+  if (it != d_automata.end())
+  {
+    return it->second.get();
+  }
+  std::unique_ptr<RegExpAutomaton>& a = d_automata[r];
+  a = RegExpAutomaton::compile(r, d_lastchar);
+  if (a != nullptr)
+  {
+    ++d_automataCompiled;
+    Trace("regexp-automata")
+        << "Compiled " << mkString(r) << " to " << a->getNumNfaStates()
+        << " states" << std::endl;
+  }
+  return a.get();
+}
+
 }  // namespace strings
 }  // namespace theory
 }  // namespace cvc5
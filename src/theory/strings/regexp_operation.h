@@ -19,6 +19,7 @@
 #define CVC5__THEORY__STRINGS__REGEXP__OPERATION_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "expr/node.h"
 #include "smt/env_obj.h"
 #include "theory/strings/skolem_cache.h"
+#include "util/statistics_stats.h"
 #include "util/string.h"
 
 namespace cvc5 {
@@ -54,6 +56,8 @@ enum RegExpConstType
   RE_C_UNKNOWN,
 };
 
+class RegExpAutomaton;
+
 class RegExpOpr : protected EnvObj
 {
   typedef std::pair<Node, cvc5::String> PairNodeStr;
@@ -85,6 +89,11 @@ class RegExpOpr : protected EnvObj
   std::map<PairNodes, Node> d_inter_cache;
   std::map<Node, std::vector<PairNodes> > d_split_cache;
   std::map<PairNodes, bool> d_inclusionCache;
+  /**
+   * Cache mapping regular expressions to their automaton, or null if they
+   * cannot be compiled.
+   */
+  std::unordered_map<Node, std::unique_ptr<RegExpAutomaton>> d_automata;
   /**
    * Helper function for mkString, pretty prints constant or variable regular
    * expression r.
@@ -106,6 +115,11 @@ class RegExpOpr : protected EnvObj
    */
   Node removeIntersection(Node r);
   void firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset);
+  /**
+   * Get the (cached) automaton for r, or null if r cannot be compiled or
+   * automata are disabled.
+   */
+  RegExpAutomaton* getAutomaton(Node r);
 
  public:
   RegExpOpr(Env& env, SkolemCache* sc);
@@ -190,10 +204,20 @@ class RegExpOpr : protected EnvObj
    * for performance reasons.
    */
   bool regExpIncludes(Node r1, Node r2);
+  /**
+   * Returns true (resp. false) if the automaton for the regular expression r
+   * shows that s is (resp. is not) a member of r, and null if r cannot be
+   * compiled to an automaton or automata are disabled.
+   */
+  Node testConstMembership(const String& s, Node r);
 
  private:
   /** pointer to the skolem cache used by this class */
   SkolemCache* d_sc;
+  /** Number of regular expressions compiled to automata */
+  IntStat d_automataCompiled;
+  /** Number of queries answered by automata */
+  IntStat d_automataQueries;
 };
 
 }  // namespace strings
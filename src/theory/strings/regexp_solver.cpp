@@ -229,11 +229,20 @@ void RegExpSolver::checkUnfold(const std::map<Node, std::vector<Node> >& mems,
       }
       Trace("strings-regexp-nf") << "Term " << atom << " is normalized to "
                                  << nx << " IN " << r << std::endl;
-      if (nx != x || changed)
+      Node tmp;
+      if (nx.isConst())
+      {
+        // If enabled, we decide the membership by the automaton for r.
+        tmp = d_regexp_opr.testConstMembership(nx.getConst<String>(), r);
+      }
+      if (tmp.isNull() && (nx != x || changed))
       {
         // We rewrite the membership nx IN r.
-        Node tmp = rewrite(nm->mkNode(STRING_IN_REGEXP, nx, r));
+        tmp = rewrite(nm->mkNode(STRING_IN_REGEXP, nx, r));
         Trace("strings-regexp-nf") << "Simplifies to " << tmp << std::endl;
+      }
+      if (!tmp.isNull())
+      {
         if (tmp.isConst())
         {
           if (tmp.getConst<bool>() == polarity)
@@ -38,10 +38,10 @@ namespace theory {
 namespace strings {
 
 SequencesRewriter::SequencesRewriter(Rewriter* r,
-                                     HistogramStat<Rewrite>* statistics)
+                                     SequencesStatistics* statistics)
     : d_statistics(statistics),
       d_rr(r),
-      d_arithEntail(r),
+      d_arithEntail(r, statistics),
       d_stringsEntail(r, d_arithEntail, *this)
 {
 }
@@ -3657,7 +3657,7 @@ Node SequencesRewriter::returnRewrite(Node node, Node ret, Rewrite r)
                            << "." << std::endl;
   if (d_statistics != nullptr)
   {
-    (*d_statistics) << r;
+    d_statistics->d_rewrites << r;
   }
   return ret;
 }
@@ -34,7 +34,7 @@ namespace strings {
 class SequencesRewriter : public TheoryRewriter
 {
  public:
-  SequencesRewriter(Rewriter* r, HistogramStat<Rewrite>* statistics);
+  SequencesRewriter(Rewriter* r, SequencesStatistics* statistics);
   /** The underlying entailment utilities */
   ArithEntail& getArithEntail();
   StringsEntail& getStringsEntail();
@@ -303,8 +303,8 @@ class SequencesRewriter : public TheoryRewriter
    * this call. Otherwise, this method simply returns ret.
    */
   Node postProcessRewrite(Node node, Node ret);
-  /** Reference to the rewriter statistics. */
-  HistogramStat<Rewrite>* d_statistics;
+  /** Pointer to the statistics (if any). */
+  SequencesStatistics* d_statistics;
   /**
    * Pointer to the rewriter. NOTE this is a cyclic dependency, and should
    * be removed.
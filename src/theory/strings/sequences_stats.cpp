@@ -36,6 +36,10 @@ SequencesStatistics::SequencesStatistics()
           "theory::strings::regexpUnfoldingsNeg")),
       d_rewrites(smtStatisticsRegistry().registerHistogram<Rewrite>(
           "theory::strings::rewrites")),
+      d_entailCacheHits(smtStatisticsRegistry().registerInt(
+          "theory::strings::entailCacheHits")),
+      d_entailCacheMisses(smtStatisticsRegistry().registerInt(
+          "theory::strings::entailCacheMisses")),
       d_conflictsEqEngine(smtStatisticsRegistry().registerInt(
           "theory::strings::conflictsEqEngine")),
       d_conflictsEager(smtStatisticsRegistry().registerInt(
@@ -79,6 +79,10 @@ class SequencesStatistics
   //--------------- end of inferences
   /** Counts the number of applications of each type of rewrite rule */
   HistogramStat<Rewrite> d_rewrites;
+  /** Number of arithmetic entailment checks answered by the cache */
+  IntStat d_entailCacheHits;
+  /** Number of arithmetic entailment checks not answered by the cache */
+  IntStat d_entailCacheMisses;
   //--------------- conflicts, partition of calls to OutputChannel::conflict
   /** Number of equality engine conflicts */
   IntStat d_conflictsEqEngine;
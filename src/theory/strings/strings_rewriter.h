@@ -33,7 +33,7 @@ class StringsRewriter : public SequencesRewriter
 {
  public:
   StringsRewriter(Rewriter* r,
-                  HistogramStat<Rewrite>* statistics,
+                  SequencesStatistics* statistics,
                   uint32_t alphaCard = 196608);
 
   RewriteResponse postRewrite(TNode node) override;
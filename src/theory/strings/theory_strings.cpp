@@ -57,7 +57,7 @@ TheoryStrings::TheoryStrings(Env& env, OutputChannel& out, Valuation valuation)
       d_state(env, d_valuation),
       d_termReg(env, d_state, d_statistics, d_pnm),
       d_rewriter(env.getRewriter(),
-                 &d_statistics.d_rewrites,
+                 &d_statistics,
                  d_termReg.getAlphabetCardinality()),
       d_eagerSolver(options().strings.stringEagerSolver
                         ? new EagerSolver(env, d_state, d_termReg)
@@ -10,23 +10,37 @@
  * directory for licensing information.
  * ****************************************************************************
  *
- * A fixed-size bit-vector, implemented as a wrapper around Integer.
+ * A fixed-size bit-vector, implemented as a machine word or a wrapper around
+ * Integer.
  */
 
 #include "util/bitvector.h"
 
+#include "base/check.h"
 #include "base/exception.h"
 
 namespace cvc5 {
 
 unsigned BitVector::getSize() const { return d_size; }
 
-const Integer& BitVector::getValue() const { return d_value; }
+const Integer& BitVector::getValue() const
+{
+  if (isWord() && !d_valueValid)
+  {
+    d_value = Integer(d_word);
+    d_valueValid = true;
+  }
+  return d_value;
+}
 
-Integer BitVector::toInteger() const { return d_value; }
+Integer BitVector::toInteger() const { return getValue(); }
 
 Integer BitVector::toSignedInteger() const
 {
+  if (isWord())
+  {
+    return Integer(toSignedWord());
+  }
   unsigned size = d_size;
   Integer sign_bit = d_value.extractBitRange(1, size - 1);
   Integer val = d_value.extractBitRange(size - 1, 0);
@@ -36,7 +50,7 @@ Integer BitVector::toSignedInteger() const
 
 std::string BitVector::toString(unsigned int base) const
 {
-  std::string str = d_value.toString(base);
+  std::string str = getValue().toString(base);
   if (base == 2 && d_size > str.size())
   {
     std::string zeroes;
@@ -54,12 +68,23 @@ std::string BitVector::toString(unsigned int base) const
 
 size_t BitVector::hash() const
 {
+  if (isWord())
+  {
+    return std::hash<uint64_t>()(d_word) + d_size;
+  }
   return d_value.hash() + d_size;
 }
 
 BitVector& BitVector::setBit(uint32_t i, bool value)
 {
   CheckArgument(i < d_size, i);
+  if (isWord())
+  {
+    uint64_t bit = uint64_t(1) << i;
+    d_word = value ? (d_word | bit) : (d_word & ~bit);
+    d_valueValid = false;
+    return *this;
+  }
   d_value.setBit(i, value);
   return *this;
 }
@@ -67,11 +92,23 @@ BitVector& BitVector::setBit(uint32_t i, bool value)
 bool BitVector::isBitSet(uint32_t i) const
 {
   CheckArgument(i < d_size, i);
+  if (isWord())
+  {
+    return (d_word >> i) & 1;
+  }
   return d_value.isBitSet(i);
 }
 
 unsigned BitVector::isPow2() const
 {
+  if (isWord())
+  {
+    if (d_word == 0 || (d_word & (d_word - 1)) != 0)
+    {
+      return 0;
+    }
+    return __builtin_ctzll(d_word) + 1;
+  }
   return d_value.isPow2();
 }
 
@@ -83,14 +120,26 @@ unsigned BitVector::isPow2() const
 
 BitVector BitVector::concat(const BitVector& other) const
 {
-  return BitVector(d_size + other.d_size,
-                   (d_value.multiplyByPow2(other.d_size)) + other.d_value);
+  unsigned size = d_size + other.d_size;
+  if (size <= 64)
+  {
+    // if other has size 64, then this has size 0
+    uint64_t high = other.d_size == 64 ? 0 : d_word << other.d_size;
+    return BitVector(size, high | other.d_word);
+  }
+  return BitVector(size,
+                   (getValue().multiplyByPow2(other.d_size))
+                       + other.getValue());
 }
 
 BitVector BitVector::extract(unsigned high, unsigned low) const
 {
   CheckArgument(high < d_size, high);
   CheckArgument(low <= high, low);
+  if (isWord())
+  {
+    return BitVector(high - low + 1, d_word >> low);
+  }
   return BitVector(high - low + 1,
                    d_value.extractBitRange(high - low + 1, low));
 }
@@ -100,51 +149,58 @@ BitVector BitVector::extract(unsigned high, unsigned low) const
 bool BitVector::operator==(const BitVector& y) const
 {
   if (d_size != y.d_size) return false;
+  if (isWord())
+  {
+    return d_word == y.d_word;
+  }
   return d_value == y.d_value;
 }
 
 bool BitVector::operator!=(const BitVector& y) const
 {
-  if (d_size != y.d_size) return true;
-  return d_value != y.d_value;
+  return !(*this == y);
 }
 
 /* Unsigned Inequality --------------------------------------------------- */
 
 bool BitVector::operator<(const BitVector& y) const
 {
-  return d_value < y.d_value;
+  if (isWord() && y.isWord())
+  {
+    return d_word < y.d_word;
+  }
+  return getValue() < y.getValue();
 }
 
 bool BitVector::operator<=(const BitVector& y) const
 {
-  return d_value <= y.d_value;
+  if (isWord() && y.isWord())
+  {
+    return d_word <= y.d_word;
+  }
+  return getValue() <= y.getValue();
 }
 
 bool BitVector::operator>(const BitVector& y) const
 {
-  return d_value > y.d_value;
+  return y < *this;
 }
 
 bool BitVector::operator>=(const BitVector& y) const
 {
-  return d_value >= y.d_value;
+  return y <= *this;
 }
 
 bool BitVector::unsignedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value < y.d_value;
+  return *this < y;
 }
 
 bool BitVector::unsignedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, this);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value <= y.d_value;
+  return *this <= y;
 }
 
 /* Signed Inequality ----------------------------------------------------- */
@@ -152,8 +208,10 @@ bool BitVector::unsignedLessThanEq(const BitVector& y) const
 bool BitVector::signedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isWord())
+  {
+    return toSignedWord() < y.toSignedWord();
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -163,8 +221,10 @@ bool BitVector::signedLessThan(const BitVector& y) const
 bool BitVector::signedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isWord())
+  {
+    return toSignedWord() <= y.toSignedWord();
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -176,23 +236,39 @@ bool BitVector::signedLessThanEq(const BitVector& y) const
 BitVector BitVector::operator^(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word ^ y.d_word);
+  }
   return BitVector(d_size, d_value.bitwiseXor(y.d_value));
 }
 
 BitVector BitVector::operator|(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word | y.d_word);
+  }
   return BitVector(d_size, d_value.bitwiseOr(y.d_value));
 }
 
 BitVector BitVector::operator&(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word & y.d_word);
+  }
   return BitVector(d_size, d_value.bitwiseAnd(y.d_value));
 }
 
 BitVector BitVector::operator~() const
 {
+  if (isWord())
+  {
+    return BitVector(d_size, ~d_word);
+  }
   return BitVector(d_size, d_value.bitwiseNot());
 }
 
@@ -201,6 +277,10 @@ BitVector BitVector::operator~() const
 BitVector BitVector::operator+(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word + y.d_word);
+  }
   Integer sum = d_value + y.d_value;
   return BitVector(d_size, sum);
 }
@@ -208,6 +288,10 @@ BitVector BitVector::operator+(const BitVector& y) const
 BitVector BitVector::operator-(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word - y.d_word);
+  }
   // to maintain the invariant that we are only adding BitVectors of the
   // same size
   BitVector one(d_size, Integer(1));
@@ -216,6 +300,10 @@ BitVector BitVector::operator-(const BitVector& y) const
 
 BitVector BitVector::operator-() const
 {
+  if (isWord())
+  {
+    return BitVector(d_size, ~d_word + 1);
+  }
   BitVector one(d_size, Integer(1));
   return ~(*this) + one;
 }
@@ -223,6 +311,10 @@ BitVector BitVector::operator-() const
 BitVector BitVector::operator*(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word * y.d_word);
+  }
   Integer prod = d_value * y.d_value;
   return BitVector(d_size, prod);
 }
@@ -230,6 +322,11 @@ BitVector BitVector::operator*(const BitVector& y) const
 BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    /* d_word / 0 = -1 = 2^d_size - 1 */
+    return BitVector(d_size, y.d_word == 0 ? ~uint64_t(0) : d_word / y.d_word);
+  }
   /* d_value / 0 = -1 = 2^d_size - 1 */
   if (y.d_value == 0)
   {
@@ -243,6 +340,10 @@ BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 BitVector BitVector::unsignedRemTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, y.d_word == 0 ? d_word : d_word % y.d_word);
+  }
   if (y.d_value == 0)
   {
     return BitVector(d_size, d_value);
@@ -256,17 +357,24 @@ BitVector BitVector::unsignedRemTotal(const BitVector& y) const
 
 BitVector BitVector::zeroExtend(unsigned n) const
 {
+  if (isWord())
+  {
+    return BitVector(d_size + n, d_word);
+  }
   return BitVector(d_size + n, d_value);
 }
 
 BitVector BitVector::signExtend(unsigned n) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
-  if (sign_bit == Integer(0))
+  if (d_size + n <= 64)
   {
-    return BitVector(d_size + n, d_value);
+    return BitVector(d_size + n, static_cast<uint64_t>(toSignedWord()));
   }
-  Integer val = d_value.oneExtend(d_size, n);
+  if (!isBitSet(d_size - 1))
+  {
+    return BitVector(d_size + n, getValue());
+  }
+  Integer val = getValue().oneExtend(d_size, n);
   return BitVector(d_size + n, val);
 }
 
@@ -274,38 +382,59 @@ BitVector BitVector::signExtend(unsigned n) const
 
 BitVector BitVector::leftShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isWord() && y.isWord())
+  {
+    return BitVector(d_size, y.d_word >= d_size ? 0 : d_word << y.d_word);
+  }
+  const Integer& yval = y.getValue();
+  if (yval > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
-  if (y.d_value == 0)
+  if (yval == 0)
   {
     return *this;
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.multiplyByPow2(amount);
+  CheckArgument(yval < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = yval.toUnsignedInt();
+  Integer res = getValue().multiplyByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::logicalRightShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isWord() && y.isWord())
+  {
+    return BitVector(d_size, y.d_word >= d_size ? 0 : d_word >> y.d_word);
+  }
+  const Integer& yval = y.getValue();
+  if (yval > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.divByPow2(amount);
+  CheckArgument(yval < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = yval.toUnsignedInt();
+  Integer res = getValue().divByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::arithRightShift(const BitVector& y) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
-  if (y.d_value > Integer(d_size))
+  if (isWord() && y.isWord())
+  {
+    int64_t val = toSignedWord();
+    if (y.d_word >= d_size)
+    {
+      return BitVector(d_size, val < 0 ? ~uint64_t(0) : 0);
+    }
+    return BitVector(d_size, static_cast<uint64_t>(val >> y.d_word));
+  }
+  const Integer& value = getValue();
+  const Integer& yval = y.getValue();
+  Integer sign_bit = value.extractBitRange(1, d_size - 1);
+  if (yval > Integer(d_size))
   {
     if (sign_bit == Integer(0))
     {
@@ -317,16 +446,16 @@ BitVector BitVector::arithRightShift(const BitVector& y) const
     }
   }
 
-  if (y.d_value == 0)
+  if (yval == 0)
   {
     return *this;
   }
 
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
+  CheckArgument(yval < Integer(1).multiplyByPow2(32), y);
 
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer rest = d_value.divByPow2(amount);
+  uint32_t amount = yval.toUnsignedInt();
+  Integer rest = value.divByPow2(amount);
 
   if (sign_bit == Integer(0))
   {
@@ -355,6 +484,10 @@ BitVector BitVector::mkOne(unsigned size)
 BitVector BitVector::mkOnes(unsigned size)
 {
   CheckArgument(size > 0, size);
+  if (size <= 64)
+  {
+    return BitVector(size, ~uint64_t(0));
+  }
   return BitVector(1, Integer(1)).signExtend(size - 1);
 }
 
@@ -372,4 +505,32 @@ BitVector BitVector::mkMaxSigned(unsigned size)
   return ~BitVector::mkMinSigned(size);
 }
 
+/* -----------------------------------------------------------------------
+ * Private helpers.
+ * ----------------------------------------------------------------------- */
+
+int64_t BitVector::toSignedWord() const
+{
+  Assert(isWord());
+  if (d_size == 0 || d_size == 64)
+  {
+    return static_cast<int64_t>(d_word);
+  }
+  unsigned shift = 64 - d_size;
+  return static_cast<int64_t>(d_word << shift) >> shift;
+}
+
+void BitVector::setValue(const Integer& val)
+{
+  if (isWord())
+  {
+    d_word = val.modByPow2(d_size).getUnsigned64();
+    d_valueValid = false;
+  }
+  else
+  {
+    d_value = val.modByPow2(d_size);
+  }
+}
+
 }  // namespace cvc5
@@ -10,7 +10,8 @@
  * directory for licensing information.
  * ****************************************************************************
  *
- * A fixed-size bit-vector, implemented as a wrapper around Integer.
+ * A fixed-size bit-vector, implemented as a machine word or a wrapper around
+ * Integer.
  */
 
 #include "cvc5_public.h"
@@ -29,12 +30,12 @@ namespace cvc5 {
 class BitVector
 {
  public:
-  BitVector(unsigned size, const Integer& val)
-      : d_size(size), d_value(val.modByPow2(size))
+  BitVector(unsigned size, const Integer& val) : d_size(size), d_word(0)
   {
+    setValue(val);
   }
 
-  BitVector(unsigned size = 0) : d_size(size), d_value(0) {}
+  BitVector(unsigned size = 0) : d_size(size), d_word(0) {}
 
   /**
    * BitVector constructor using a 32-bit unsigned integer for the value.
@@ -43,10 +44,7 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint32_t z) : d_size(size), d_value(z)
-  {
-    d_value = d_value.modByPow2(size);
-  }
+  BitVector(unsigned size, uint32_t z) : BitVector(size, uint64_t(z)) {}
 
   /**
    * BitVector constructor using a 64-bit unsigned integer for the value.
@@ -55,14 +53,28 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint64_t z) : d_size(size), d_value(z)
+  BitVector(unsigned size, uint64_t z) : d_size(size), d_word(0)
   {
-    d_value = d_value.modByPow2(size);
+    if (isWord())
+    {
+      d_word = z & mask(size);
+    }
+    else
+    {
+      d_value = Integer(z);
+    }
   }
 
-  BitVector(unsigned size, const BitVector& q)
-      : d_size(size), d_value(q.d_value)
+  BitVector(unsigned size, const BitVector& q) : d_size(size), d_word(0)
   {
+    if (isWord() && q.isWord())
+    {
+      d_word = q.d_word & mask(size);
+    }
+    else
+    {
+      setValue(q.getValue());
+    }
   }
 
   /**
@@ -79,19 +91,20 @@ class BitVector
    *            This cannot be a negative value.
    * @param base The base of the string representation.
    */
-  BitVector(const std::string& num, unsigned base = 2)
+  BitVector(const std::string& num, unsigned base = 2) : d_word(0)
   {
     CheckArgument(base == 2 || base == 10 || base == 16, base);
     CheckArgument(num[0] != '-', num);
-    d_value = Integer(num, base);
-    CheckArgument(d_value == d_value.abs(), num);
+    Integer val(num, base);
+    CheckArgument(val == val.abs(), num);
     // Compute the length, *without* any negative sign.
     switch (base)
     {
-      case 10: d_size = d_value.length(); break;
+      case 10: d_size = val.length(); break;
       case 16: d_size = num.size() * 4; break;
       default: d_size = num.size();
     }
+    setValue(val);
   }
 
   ~BitVector() {}
@@ -100,7 +113,9 @@ class BitVector
   {
     if (this == &x) return *this;
     d_size = x.d_size;
+    d_word = x.d_word;
     d_value = x.d_value;
+    d_valueValid = x.d_valueValid;
     return *this;
   }
 
@@ -269,12 +284,32 @@ class BitVector
  private:
   /**
    * Class invariants:
-   *  - no overflows: 2^d_size < d_value
-   *  - no negative numbers: d_value >= 0
+   *  - no overflows: 2^d_size < value
+   *  - no negative numbers: value >= 0
+   *
+   * Bit-vectors of size at most 64 store their value in the machine word
+   * d_word, and all operations on them are done on machine words, without
+   * allocating. Larger bit-vectors store their value in d_value. For the
+   * former, d_value caches the Integer value returned by getValue(), which is
+   * valid if d_valueValid is true.
    */
 
+  /* Return true if the value of this is stored in d_word. */
+  bool isWord() const { return d_size <= 64; }
+  /* Return the mask for the values of bit-vectors of given size <= 64. */
+  static uint64_t mask(unsigned size)
+  {
+    return size >= 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+  }
+  /* Return the two's complement interpretation of d_word. */
+  int64_t toSignedWord() const;
+  /* Set the value of this to val modulo 2^d_size. */
+  void setValue(const Integer& val);
+
   unsigned d_size;
-  Integer d_value;
+  uint64_t d_word;
+  mutable Integer d_value;
+  mutable bool d_valueValid = false;
 
 }; /* class BitVector */
 
@@ -33,31 +33,133 @@ static_assert(UCHAR_MAX == 255, "Unsigned char is assumed to have 256 values.");
 
 String::String(const std::wstring& s)
 {
-  d_str.resize(s.size());
+  std::vector<unsigned> vec(s.size());
   for (size_t i = 0, n = s.size(); i < n; ++i)
   {
-    d_str[i] = static_cast<unsigned>(s[i]);
+    vec[i] = static_cast<unsigned>(s[i]);
   }
+  assign(vec);
 }
 
-String::String(const std::vector<unsigned> &s) : d_str(s)
+String::String(const std::vector<unsigned>& s) { assign(s); }
+
+void String::assign(const std::vector<unsigned>& vec)
 {
-#ifdef CVC5_ASSERTIONS
-  for (unsigned u : d_str)
+  d_wide = false;
+  for (unsigned u : vec)
   {
     Assert(u < num_codes());
+    if (u > UCHAR_MAX)
+    {
+      d_wide = true;
+    }
   }
-#endif
+  if (!d_wide)
+  {
+    d_str.assign(vec.begin(), vec.end());
+    return;
+  }
+  d_str.resize(4 * vec.size());
+  for (size_t i = 0, n = vec.size(); i < n; ++i)
+  {
+    uint32_t c = vec[i];
+    std::memcpy(&d_str[4 * i], &c, 4);
+  }
+}
+
+void String::narrow()
+{
+  if (!d_wide)
+  {
+    return;
+  }
+  size_t n = size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    if ((*this)[i] > UCHAR_MAX)
+    {
+      return;
+    }
+  }
+  std::string str(n, '\0');
+  for (size_t i = 0; i < n; ++i)
+  {
+    str[i] = static_cast<char>((*this)[i]);
+  }
+  d_str = std::move(str);
+  d_wide = false;
+}
+
+void String::widen()
+{
+  if (d_wide)
+  {
+    return;
+  }
+  size_t n = size();
+  std::string str(4 * n, '\0');
+  for (size_t i = 0; i < n; ++i)
+  {
+    uint32_t c = static_cast<unsigned char>(d_str[i]);
+    std::memcpy(&str[4 * i], &c, 4);
+  }
+  d_str = std::move(str);
+  d_wide = true;
+}
+
+std::vector<unsigned> String::getVec() const
+{
+  std::vector<unsigned> vec(size());
+  for (size_t i = 0, n = vec.size(); i < n; ++i)
+  {
+    vec[i] = (*this)[i];
+  }
+  return vec;
+}
+
+bool String::rangeEquals(std::size_t i,
+                         const String& y,
+                         std::size_t j,
+                         std::size_t n) const
+{
+  Assert(i + n <= size() && j + n <= y.size());
+  if (d_wide == y.d_wide)
+  {
+    // compare the bytes, which is vectorized by the standard library
+    size_t w = width();
+    return std::memcmp(d_str.data() + w * i, y.d_str.data() + w * j, w * n)
+           == 0;
+  }
+  for (size_t k = 0; k < n; ++k)
+  {
+    if ((*this)[i + k] != y[j + k])
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 int String::cmp(const String &y) const {
   if (size() != y.size()) {
     return size() < y.size() ? -1 : 1;
   }
-  for (unsigned int i = 0; i < size(); ++i) {
-    if (d_str[i] != y.d_str[i]) {
-      unsigned cp = d_str[i];
-      unsigned cpy = y.d_str[i];
+  if (!d_wide && !y.d_wide)
+  {
+    // bytes are compared as unsigned characters
+    int c = d_str.compare(y.d_str);
+    return c == 0 ? 0 : (c < 0 ? -1 : 1);
+  }
+  if (d_wide && y.d_wide && d_str == y.d_str)
+  {
+    return 0;
+  }
+  for (size_t i = 0, n = size(); i < n; ++i)
+  {
+    unsigned cp = (*this)[i];
+    unsigned cpy = y[i];
+    if (cp != cpy)
+    {
       return cp < cpy ? -1 : 1;
     }
   }
@@ -65,9 +167,23 @@ int String::cmp(const String &y) const {
 }
 
 String String::concat(const String &other) const {
-  std::vector<unsigned int> ret_vec(d_str);
-  ret_vec.insert(ret_vec.end(), other.d_str.begin(), other.d_str.end());
-  return String(ret_vec);
+  String ret(*this);
+  if (d_wide == other.d_wide)
+  {
+    ret.d_str.append(other.d_str);
+  }
+  else if (d_wide)
+  {
+    String o(other);
+    o.widen();
+    ret.d_str.append(o.d_str);
+  }
+  else
+  {
+    ret.widen();
+    ret.d_str.append(other.d_str);
+  }
+  return ret;
 }
 
 bool String::strncmp(const String& y, std::size_t n) const
@@ -81,10 +197,7 @@ bool String::strncmp(const String& y, std::size_t n) const
       return false;
     }
   }
-  for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[i] != y.d_str[i]) return false;
-  }
-  return true;
+  return rangeEquals(0, y, 0, n);
 }
 
 bool String::rstrncmp(const String& y, std::size_t n) const
@@ -98,10 +211,7 @@ bool String::rstrncmp(const String& y, std::size_t n) const
       return false;
     }
   }
-  for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[size() - i - 1] != y.d_str[y.size() - i - 1]) return false;
-  }
-  return true;
+  return rangeEquals(size() - n, y, y.size() - n, n);
 }
 
 void String::addCharToInternal(unsigned char ch, std::vector<unsigned>& str)
@@ -249,21 +359,20 @@ std::vector<unsigned> String::toInternal(const std::string& s,
 unsigned String::front() const
 {
   Assert(!d_str.empty());
-  return d_str.front();
+  return (*this)[0];
 }
 
 unsigned String::back() const
 {
   Assert(!d_str.empty());
-  return d_str.back();
+  return (*this)[size() - 1];
 }
 
 std::size_t String::overlap(const String &y) const {
   std::size_t i = size() < y.size() ? size() : y.size();
   for (; i > 0; i--) {
-    String s = suffix(i);
-    String p = y.prefix(i);
-    if (s == p) {
+    if (rangeEquals(size() - i, y, 0, i))
+    {
       return i;
     }
   }
@@ -273,9 +382,8 @@ std::size_t String::overlap(const String &y) const {
 std::size_t String::roverlap(const String &y) const {
   std::size_t i = size() < y.size() ? size() : y.size();
   for (; i > 0; i--) {
-    String s = prefix(i);
-    String p = y.suffix(i);
-    if (s == p) {
+    if (rangeEquals(0, y, y.size() - i, i))
+    {
       return i;
     }
   }
@@ -288,14 +396,15 @@ std::string String::toString(bool useEscSequences) const {
     // we always print backslash as a code point so that it cannot be
     // interpreted as specifying part of a code point, e.g. the string '\' +
     // 'u' + '0' of length three.
-    if (isPrintable(d_str[i]) && d_str[i] != '\\' && !useEscSequences)
+    unsigned c = (*this)[i];
+    if (isPrintable(c) && c != '\\' && !useEscSequences)
     {
-      str << static_cast<char>(d_str[i]);
+      str << static_cast<char>(c);
     }
     else
     {
       std::stringstream ss;
-      ss << std::hex << d_str[i];
+      ss << std::hex << c;
       str << "\\u{" << ss.str() << "}";
     }
   }
@@ -307,7 +416,7 @@ std::wstring String::toWString() const
   std::wstring res(size(), static_cast<wchar_t>(0));
   for (std::size_t i = 0; i < size(); ++i)
   {
-    res[i] = static_cast<wchar_t>(d_str[i]);
+    res[i] = static_cast<wchar_t>((*this)[i]);
   }
   return res;
 }
@@ -320,8 +429,8 @@ bool String::isLeq(const String &y) const
     {
       return false;
     }
-    unsigned ci = d_str[i];
-    unsigned cyi = y.d_str[i];
+    unsigned ci = (*this)[i];
+    unsigned cyi = y[i];
     if (ci > cyi)
     {
       return false;
@@ -336,9 +445,9 @@ bool String::isLeq(const String &y) const
 
 bool String::isRepeated() const {
   if (size() > 1) {
-    unsigned int f = d_str[0];
+    unsigned int f = (*this)[0];
     for (unsigned i = 1; i < size(); ++i) {
-      if (f != d_str[i]) return false;
+      if (f != (*this)[i]) return false;
     }
   }
   return true;
@@ -348,7 +457,7 @@ bool String::tailcmp(const String &y, int &c) const {
   int id_x = size() - 1;
   int id_y = y.size() - 1;
   while (id_x >= 0 && id_y >= 0) {
-    if (d_str[id_x] != y.d_str[id_y]) {
+    if ((*this)[id_x] != y[id_y]) {
       c = id_x;
       return false;
     }
@@ -364,10 +473,33 @@ std::size_t String::find(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_iterator itr = std::search(
-      d_str.begin() + start, d_str.end(), y.d_str.begin(), y.d_str.end());
-  if (itr != d_str.end()) {
-    return itr - d_str.begin();
+  if (y.d_wide && !d_wide)
+  {
+    // y has a character that does not occur in this string
+    return std::string::npos;
+  }
+  if (d_wide == y.d_wide)
+  {
+    // use the (vectorized) byte search, where in the wide representation, we
+    // skip matches that are not aligned to characters
+    size_t w = width();
+    for (size_t pos = d_str.find(y.d_str, w * start);
+         pos != std::string::npos;
+         pos = d_str.find(y.d_str, pos + 1))
+    {
+      if (pos % w == 0)
+      {
+        return pos / w;
+      }
+    }
+    return std::string::npos;
+  }
+  for (size_t i = start, last = size() - y.size(); i <= last; ++i)
+  {
+    if (rangeEquals(i, y, 0, y.size()))
+    {
+      return i;
+    }
   }
   return std::string::npos;
 }
@@ -377,68 +509,59 @@ std::size_t String::rfind(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_reverse_iterator itr = std::search(
-      d_str.rbegin() + start, d_str.rend(), y.d_str.rbegin(), y.d_str.rend());
-  if (itr != d_str.rend()) {
-    return itr - d_str.rbegin();
+  if (y.d_wide && !d_wide)
+  {
+    // y has a character that does not occur in this string
+    return std::string::npos;
   }
-  return std::string::npos;
-}
-
-bool String::hasPrefix(const String& y) const
-{
-  size_t s = size();
-  size_t ys = y.size();
-  if (ys > s)
+  // the result is the distance of the end of the last occurrence of y that
+  // ends at most at index size() - start to the end of this string
+  size_t last = size() - start - y.size();
+  if (d_wide == y.d_wide)
   {
-    return false;
+    size_t w = width();
+    for (size_t pos = d_str.rfind(y.d_str, w * last);
+         pos != std::string::npos;
+         pos = pos == 0 ? std::string::npos : d_str.rfind(y.d_str, pos - 1))
+    {
+      if (pos % w == 0)
+      {
+        return size() - pos / w - y.size();
+      }
+    }
+    return std::string::npos;
   }
-  for (size_t i = 0; i < ys; i++)
+  for (size_t i = last + 1; i > 0; --i)
   {
-    if (d_str[i] != y.d_str[i])
+    if (rangeEquals(i - 1, y, 0, y.size()))
     {
-      return false;
+      return size() - (i - 1) - y.size();
     }
   }
-  return true;
+  return std::string::npos;
+}
+
+bool String::hasPrefix(const String& y) const
+{
+  return y.size() <= size() && rangeEquals(0, y, 0, y.size());
 }
 
 bool String::hasSuffix(const String& y) const
 {
-  size_t s = size();
-  size_t ys = y.size();
-  if (ys > s)
-  {
-    return false;
-  }
-  size_t idiff = s - ys;
-  for (size_t i = 0; i < ys; i++)
-  {
-    if (d_str[i + idiff] != y.d_str[i])
-    {
-      return false;
-    }
-  }
-  return true;
+  return y.size() <= size() && rangeEquals(size() - y.size(), y, 0, y.size());
 }
 
 String String::update(std::size_t i, const String& t) const
 {
   if (i < size())
   {
-    std::vector<unsigned> vec(d_str.begin(), d_str.begin() + i);
     size_t remNum = size() - i;
-    size_t tnum = t.d_str.size();
+    size_t tnum = t.size();
     if (tnum >= remNum)
     {
-      vec.insert(vec.end(), t.d_str.begin(), t.d_str.begin() + remNum);
-    }
-    else
-    {
-      vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
-      vec.insert(vec.end(), d_str.begin() + i + tnum, d_str.end());
+      return prefix(i).concat(t.prefix(remNum));
     }
-    return String(vec);
+    return prefix(i).concat(t).concat(substr(i + tnum));
   }
   return *this;
 }
@@ -446,11 +569,7 @@ String String::update(std::size_t i, const String& t) const
 String String::replace(const String &s, const String &t) const {
   std::size_t ret = find(s);
   if (ret != std::string::npos) {
-    std::vector<unsigned> vec;
-    vec.insert(vec.begin(), d_str.begin(), d_str.begin() + ret);
-    vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
-    vec.insert(vec.end(), d_str.begin() + ret + s.size(), d_str.end());
-    return String(vec);
+    return prefix(ret).concat(t).concat(substr(ret + s.size()));
   } else {
     return *this;
   }
@@ -458,18 +577,16 @@ String String::replace(const String &s, const String &t) const {
 
 String String::substr(std::size_t i) const {
   Assert(i <= size());
-  std::vector<unsigned> ret_vec;
-  std::vector<unsigned>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, d_str.end());
-  return String(ret_vec);
+  return substr(i, size() - i);
 }
 
 String String::substr(std::size_t i, std::size_t j) const {
   Assert(i + j <= size());
-  std::vector<unsigned> ret_vec;
-  std::vector<unsigned>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, itr + j);
-  return String(ret_vec);
+  String ret;
+  ret.d_str = d_str.substr(width() * i, width() * j);
+  ret.d_wide = d_wide;
+  ret.narrow();
+  return ret;
 }
 
 bool String::noOverlapWith(const String& y) const
@@ -483,8 +600,9 @@ bool String::isNumber() const {
   if (d_str.empty()) {
     return false;
   }
-  for (unsigned character : d_str) {
-    if (!isDigit(character))
+  for (size_t i = 0, n = size(); i < n; ++i)
+  {
+    if (!isDigit((*this)[i]))
     {
       return false;
     }
@@ -525,9 +643,9 @@ namespace strings {
 size_t StringHashFunction::operator()(const ::cvc5::String& s) const
 {
   uint64_t ret = fnv1a::offsetBasis;
-  for (unsigned c : s.d_str)
+  for (size_t i = 0, n = s.size(); i < n; ++i)
   {
-    ret = fnv1a::fnv1a_64(c, ret);
+    ret = fnv1a::fnv1a_64(s[i], ret);
   }
   return static_cast<size_t>(ret);
 }
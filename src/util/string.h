@@ -18,6 +18,8 @@
 #ifndef CVC5__UTIL__STRING_H
 #define CVC5__UTIL__STRING_H
 
+#include <cstdint>
+#include <cstring>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -53,8 +55,12 @@ class String
   static inline unsigned num_codes() { return 196608; }
   /** constructors for String
    *
-   * Internally, a cvc5::String is represented by a vector of unsigned
-   * integers (d_str) representing the code points of the characters.
+   * Internally, a cvc5::String stores the code points of its characters in
+   * d_str, using one byte per character if all code points are less than 256
+   * and four bytes per character otherwise (see d_wide). The representation
+   * is canonical, that is, a string is stored with four bytes per character
+   * if and only if it has a character whose code point is at least 256. Since
+   * d_str is a std::string, short strings are stored without allocation.
    *
    * To build a string from a C++ string, we may process escape sequences
    * according to the SMT-LIB standard. In particular, if useEscSequences is
@@ -72,23 +78,16 @@ class String
    */
   String() = default;
   explicit String(const std::string& s, bool useEscSequences = false)
-      : d_str(toInternal(s, useEscSequences))
   {
+    assign(toInternal(s, useEscSequences));
   }
   explicit String(const std::wstring& s);
   explicit String(const char* s, bool useEscSequences = false)
-      : d_str(toInternal(std::string(s), useEscSequences))
   {
+    assign(toInternal(std::string(s), useEscSequences));
   }
   explicit String(const std::vector<unsigned>& s);
 
-  String& operator=(const String& y) {
-    if (this != &y) {
-      d_str = y.d_str;
-    }
-    return *this;
-  }
-
   String concat(const String& other) const;
 
   bool operator==(const String& y) const { return cmp(y) == 0; }
@@ -135,7 +134,7 @@ class String
   /** is less than or equal to string y */
   bool isLeq(const String& y) const;
   /** Return the length of the string */
-  std::size_t size() const { return d_str.size(); }
+  std::size_t size() const { return d_str.size() / width(); }
 
   bool isRepeated() const;
   bool tailcmp(const String& y, int& c) const;
@@ -213,8 +212,23 @@ class String
   bool isNumber() const;
   /** Returns the corresponding rational for the text of this string. */
   Rational toNumber() const;
-  /** Get the unsigned representation (code points) of this string */
-  const std::vector<unsigned>& getVec() const { return d_str; }
+  /**
+   * Get the unsigned representation (code points) of this string. This
+   * constructs a new vector, use size() and the subscript operator to
+   * access single characters.
+   */
+  std::vector<unsigned> getVec() const;
+  /** Get the unsigned (code point) value of the i^th character */
+  unsigned operator[](std::size_t i) const
+  {
+    if (!d_wide)
+    {
+      return static_cast<unsigned char>(d_str[i]);
+    }
+    uint32_t c;
+    std::memcpy(&c, d_str.data() + 4 * i, 4);
+    return c;
+  }
   /**
    * Get the unsigned (code point) value of the first character in this string
    */
@@ -242,10 +256,25 @@ class String
 
   /**
    * Returns the maximum length of string representable by this class.
-   * Corresponds to the maximum size of d_str.
    */
   static size_t maxSize();
  private:
+  /** Set the code points of this string to vec */
+  void assign(const std::vector<unsigned>& vec);
+  /** Use one byte per character if possible */
+  void narrow();
+  /** Use four bytes per character */
+  void widen();
+  /** Get the number of bytes per character */
+  std::size_t width() const { return d_wide ? 4 : 1; }
+  /**
+   * Returns true if the n characters of this string starting at index i are
+   * equal to the n characters of y starting at index j.
+   */
+  bool rangeEquals(std::size_t i,
+                   const String& y,
+                   std::size_t j,
+                   std::size_t n) const;
   /**
    * Helper for toInternal: add character ch to vector vec, storing a string in
    * internal format. This throws an error if ch is not a printable character,
@@ -266,7 +295,10 @@ class String
    */
   int cmp(const String& y) const;
 
-  std::vector<unsigned> d_str;
+  /** The code points, stored with width() bytes per character */
+  std::string d_str;
+  /** Whether we store four bytes per character */
+  bool d_wide = false;
 }; /* class String */
 
 namespace strings {
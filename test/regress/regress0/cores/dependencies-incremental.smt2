@@ -0,0 +1,24 @@
+; COMMAND-LINE: --incremental --unsat-cores-mode=dependencies --simplification=none --check-unsat-cores
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: a1
+; EXPECT: a2
+; EXPECT: a4
+; EXPECT: )
+; The assertions a1 and a3 are rewritten to the same assertion, whose
+; dependencies are those of a3 after the first check. This assertion is used
+; in the second check, after a3 was popped, hence the core falls back to all
+; inputs, including the unused assertion a2.
+(set-logic QF_LIA)
+(declare-const x Int)
+(declare-const y Int)
+(assert (! (< x 0) :named a1))
+(assert (! (> y 0) :named a2))
+(push 1)
+(assert (! (> 0 x) :named a3))
+(check-sat)
+(pop 1)
+(assert (! (> x 0) :named a4))
+(check-sat)
+(get-unsat-core)
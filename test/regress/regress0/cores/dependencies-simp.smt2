@@ -0,0 +1,22 @@
+; COMMAND-LINE: --unsat-cores-mode=dependencies --check-unsat-cores
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: a1
+; EXPECT: a2
+; EXPECT: a3
+; EXPECT: a4
+; EXPECT: )
+; Non-clausal simplification learns the substitution x -> 5 and applies it to
+; a3. Neither this pass nor applying the substitutions afterwards replaces
+; each assertion by one that depends on it only, hence the core falls back to
+; all inputs, including the unused assertion a4.
+(set-logic QF_LIA)
+(declare-const x Int)
+(declare-const y Int)
+(declare-const z Int)
+(assert (! (= x 5) :named a1))
+(assert (! (> y 0) :named a2))
+(assert (! (< (+ x y) 3) :named a3))
+(assert (! (< z 10) :named a4))
+(check-sat)
+(get-unsat-core)
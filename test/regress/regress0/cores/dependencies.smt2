@@ -0,0 +1,15 @@
+; COMMAND-LINE: --unsat-cores-mode=dependencies --simplification=none --check-unsat-cores
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: a1
+; EXPECT: a3
+; EXPECT: )
+(set-logic QF_LIA)
+(declare-const x Int)
+(declare-const y Int)
+(declare-const z Int)
+(assert (! (> x (ite (> y 0) y 0)) :named a1))
+(assert (! (< z 10) :named a2))
+(assert (! (< x 0) :named a3))
+(check-sat)
+(get-unsat-core)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --minimal-unsat-cores --minimal-unsat-cores-mode=quickxplain
+; COMMAND-LINE: --minimal-unsat-cores --no-minimal-unsat-cores-refine
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: a2
+; EXPECT: a4
+; EXPECT: )
+(set-logic QF_LIA)
+(declare-const x Int)
+(declare-const y Int)
+(assert (! (> x 0) :named a1))
+(assert (! (> x 5) :named a2))
+(assert (! (> y 0) :named a3))
+(assert (! (< x 3) :named a4))
+(check-sat)
+(get-unsat-core)
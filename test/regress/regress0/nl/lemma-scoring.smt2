@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental --nl-ext=full --nl-ext-lemma-scoring
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (> (* x y z) 1))
+(push)
+(assert (< x 0))
+(assert (> y 0))
+(assert (> z 0))
+(check-sat)
+(pop)
+(push)
+(assert (> x 2))
+(assert (> y 2))
+(assert (> z 1))
+(assert (< (* x y) 4))
+(check-sat)
+(pop)
+(push)
+(assert (> x 0))
+(assert (< y 0))
+(assert (> z 0))
+(check-sat)
+(pop)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --check-proofs --proof-hash-cons
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(assert (= a b))
+(assert (= b c))
+(assert (= c d))
+(assert (or (not (= (f a) (f d))) (not (= (f (f a)) (f (f d))))))
+(assert (or (not (= (f d) (f a))) (not (= (f (f b)) (f (f c))))))
+(check-sat)
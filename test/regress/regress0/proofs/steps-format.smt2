@@ -0,0 +1,18 @@
+; COMMAND-LINE: --dump-proofs --proof-format-mode=steps --proof-hash-cons
+; SCRUBBER: awk '/^(unsat|\(proof|\))$/{print} /^\(step /{n++; if ($2 != "s" n) bad++; s=$0; sub(/^\(step s[0-9]+ /,"",s); if (s !~ /:rule ASSUME/ && (s in steps)) dup++; steps[s]=1; if (match($0,/:premises \([^)]*\)/)) {np++; k=split(substr($0,RSTART+11,RLENGTH-12),ps," "); for(i=1;i<=k;i++) if (substr(ps[i],2)+0 >= n) bad++}} END{print "steps with premises: " (np>0); print "bad step ids: " bad+0; print "duplicate steps: " dup+0}'
+; EXPECT: unsat
+; EXPECT: (proof
+; EXPECT: )
+; EXPECT: steps with premises: 1
+; EXPECT: bad step ids: 0
+; EXPECT: duplicate steps: 0
+;
+; The scrubber checks that the steps are numbered s1, s2, ... in order, that
+; premises only refer to earlier steps, and that no step except an assumption
+; is printed twice, i.e. each shared proof node is printed once.
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(assert (and a b))
+(assert (not a))
+(check-sat)
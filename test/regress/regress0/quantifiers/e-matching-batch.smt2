@@ -0,0 +1,15 @@
+; COMMAND-LINE: --e-matching-batch
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-const a U)
+(declare-const b U)
+(assert (forall ((x U)) (=> (P x) (P (f x)))))
+(assert (forall ((x U)) (! (= (g (f x)) x) :pattern ((f x)) :pattern ((g x)))))
+(assert (P a))
+(assert (= b (f a)))
+(assert (or (not (P b)) (not (= (g b) a))))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --e-matching-inc
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-const a U)
+(assert (forall ((x U)) (! (P (f x)) :pattern ((f x)))))
+(assert (forall ((y U)) (! (not (Q (g y))) :pattern ((g y)))))
+; In the first branch, the instantiation of the first formula for a is
+; entailed and the branch is closed by the second formula. The second branch
+; needs the instantiation, although f(a) has not changed since.
+(assert (or (and (P (f a)) (Q (g a))) (not (P (f a)))))
+(check-sat)
@@ -0,0 +1,22 @@
+; COMMAND-LINE: --e-matching-inc --incremental
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-const a U)
+(declare-const b U)
+(declare-const c U)
+(assert (forall ((x U)) (! (P (f x a)) :pattern ((f x a)))))
+(assert (forall ((y U)) (! (= (g (f y a)) y) :pattern ((f y a)))))
+(assert (= (g (f b a)) c))
+(push 1)
+(assert (not (P (f b a))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (= b c)))
+(check-sat)
+(pop 1)
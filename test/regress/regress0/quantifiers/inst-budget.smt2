@@ -0,0 +1,10 @@
+; COMMAND-LINE: --inst-budget=1
+; EXPECT: unsat
+(set-logic UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun g (Int) Int)
+(assert (forall ((x Int)) (! (> (f (+ x 1)) (f x)) :pattern ((f x)))))
+(assert (forall ((x Int)) (! (> (g (+ x 1)) (g x)) :pattern ((g x)))))
+(assert (> (f 0) (f 3)))
+(assert (= (g 0) (f 0)))
+(check-sat)
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --inst-table --incremental
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun h (U) U)
+(declare-fun P (U) Bool)
+(declare-const b U)
+(declare-const c U)
+(assert (forall ((x U)) (! (P x) :pattern ((h x)))))
+(push 1)
+(assert (= (h b) b))
+(assert (not (P b)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (h b) c))
+(assert (not (P b)))
+(check-sat)
+(pop 1)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --trigger-code-tree
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-const a U)
+(declare-const b U)
+(declare-const c U)
+(assert (forall ((x U)) (! (P (f x a)) :pattern ((f x a)))))
+(assert (forall ((y U)) (! (= (g (f y a)) y) :pattern ((f y a)))))
+(assert (forall ((x U) (y U)) (! (= (f x y) (f y x)) :pattern ((f x y)))))
+(assert (forall ((z U)) (! (=> (P (f z z)) (P z)) :pattern ((f z z)))))
+(assert (= (g (f b a)) c))
+(assert (or (not (P (f b a))) (not (= b c))))
+(check-sat)
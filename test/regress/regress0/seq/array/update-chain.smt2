@@ -0,0 +1,20 @@
+; COMMAND-LINE: --strings-exp --seq-array=eager
+; EXPECT: unsat
+
+(set-logic ALL)
+(set-info :status unsat)
+
+(declare-fun a () (Seq Int))
+(declare-fun a1 () (Seq Int))
+(declare-fun a2 () (Seq Int))
+(declare-fun a3 () (Seq Int))
+(declare-fun i () Int)
+
+(assert (>= (seq.len a) 2))
+(assert (= a1 (seq.update a 0 (seq.unit 1))))
+(assert (= a2 (seq.update a1 1 (seq.unit 2))))
+(assert (= a3 (seq.update a2 i (seq.unit 3))))
+(assert (not (= i 1)))
+(assert (not (= (seq.nth a3 1) 2)))
+
+(check-sat)
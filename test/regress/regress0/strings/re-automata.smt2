@@ -0,0 +1,13 @@
+; COMMAND-LINE: --strings-exp --re-automata
+(set-info :status unsat)
+(set-logic ALL)
+(declare-const x String)
+(declare-const y String)
+
+(assert (str.in_re x (re.* (re.union (str.to_re "a") (str.to_re "b")))))
+(assert (not (str.in_re x (re.* (re.++ (re.* (str.to_re "a")) (re.* (str.to_re "b")))))))
+
+(assert (str.in_re y (re.++ (re.+ (re.range "a" "c")) (str.to_re "d"))))
+(assert (str.in_re y (re.comp (re.++ re.all (str.to_re "d")))))
+
+(check-sat)
@@ -0,0 +1,14 @@
+; EXPECT: unsat
+(set-logic QF_UFLRA)
+(declare-fun f (Real) Real)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun w () Real)
+(assert (<= x y))
+(assert (<= y z))
+(assert (<= z x))
+(assert (or (> (f y) w) (> (f z) (+ w 1.0))))
+(assert (or (< (f x) w) (< (f y) (- w 1.0))))
+(assert (or (< x z) (distinct (f x) (f z)) (> w (f y))))
+(check-sat)
@@ -21,6 +21,7 @@ import difflib
 import os
 import re
 import shlex
+import shutil
 import subprocess
 import sys
 import tempfile
@@ -292,6 +293,52 @@ class DumpTester(Tester):
         return exit_code
 
 
+class DratTester(Tester):
+    """Checks the DRAT proof of the SAT solver with drat-trim if it is
+    installed, and with the (slow) RUP checker check_rup_proof otherwise.
+    This tester is not run by default."""
+
+    def applies(self, benchmark_info):
+        return (
+            benchmark_info.benchmark_ext == ".smt2"
+            and benchmark_info.expected_output.split() == ["unsat"]
+            and "--incremental" not in benchmark_info.command_line_args
+        )
+
+    def run(self, benchmark_info):
+        drat_trim = shutil.which("drat-trim")
+        with tempfile.TemporaryDirectory() as tmpdir:
+            drat_file = os.path.join(tmpdir, "proof.drat")
+            exit_code = super().run(
+                benchmark_info._replace(
+                    command_line_args=benchmark_info.command_line_args
+                    + ["--sat-drat-file={}".format(drat_file)]
+                )
+            )
+            if exit_code != EXIT_OK:
+                return exit_code
+            if drat_trim:
+                output, _, _ = run_process(
+                    [drat_trim, drat_file + ".cnf", drat_file],
+                    benchmark_info.benchmark_dir,
+                    benchmark_info.timeout,
+                )
+                if isinstance(output, bytes):
+                    output = output.decode()
+                verified = "s VERIFIED" in output
+            else:
+                verified, output = check_rup_proof(
+                    drat_file + ".cnf", drat_file
+                )
+            if not verified:
+                print("not ok - DRAT proof not verified")
+                print("=" * 80)
+                print(output)
+                print("=" * 80)
+                return EXIT_FAILURE
+        return EXIT_OK
+
+
 g_testers = {
     "base": BaseTester(),
     "unsat-core": UnsatCoreTester(),
@@ -300,6 +347,7 @@ g_testers = {
     "synth": SynthTester(),
     "abduct": AbductTester(),
     "dump": DumpTester(),
+    "drat": DratTester(),
 }
 
 g_default_testers = [
@@ -425,6 +473,68 @@ def get_cvc5_features(cvc5_binary):
     return features, disabled_features
 
 
+def check_rup_proof(cnf_file, proof_file):
+    """Checks that the clausal proof in proof_file derives the empty clause
+    from the clauses of the DIMACS file cnf_file, where each derived clause
+    must follow by unit propagation (RUP) from the previous clauses. This is
+    sufficient for the proofs of the SAT solver, which do not use RAT steps.
+    Deletions are ignored, which keeps the check sound. Returns a pair of
+    whether the proof was verified and a message."""
+
+    def read_lines(filename):
+        with open(filename) as f:
+            return [line.split() for line in f if line.strip()]
+
+    def to_clause(line):
+        return [int(l) for l in line if l != "d"]
+
+    def propagate(clauses, assignment):
+        # Returns false if unit propagation derives a conflict
+        if any(-l in assignment for l in assignment):
+            return False
+        changed = True
+        while changed:
+            changed = False
+            for c in clauses:
+                unassigned = None
+                satisfied = False
+                num_unassigned = 0
+                for l in c[:-1]:
+                    if l in assignment:
+                        satisfied = True
+                        break
+                    if -l not in assignment:
+                        unassigned = l
+                        num_unassigned += 1
+                if satisfied:
+                    continue
+                if num_unassigned == 0:
+                    return False
+                if num_unassigned == 1:
+                    assignment.add(unassigned)
+                    changed = True
+        return True
+
+    cnf_lines = read_lines(cnf_file)
+    header = cnf_lines[0] if cnf_lines else []
+    if header[:2] != ["p", "cnf"]:
+        return False, "missing header in {}".format(cnf_file)
+    clauses = [to_clause(line) for line in cnf_lines[1:]]
+    num_vars = max([abs(l) for c in clauses for l in c] + [0])
+    if header[2:] != [str(num_vars), str(len(clauses))]:
+        return False, "wrong header in {}: {}".format(cnf_file, header)
+    for line in read_lines(proof_file):
+        if line[0] == "d":
+            continue
+        c = to_clause(line)
+        if propagate(clauses, set(-l for l in c[:-1])):
+            return False, "clause is not RUP: {}".format(" ".join(line))
+        if len(c) == 1:
+            return True, "verified"
+        clauses.append(c)
+    return False, "the proof does not derive the empty clause"
+
+
 def run_benchmark(benchmark_info):
     """Runs cvc5 on a benchmark with the given `benchmark_info`. It runs on the
     file `benchmark_basename` in the directory `benchmark_dir` using the binary
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of node_signature_table.{h,cpp}
+ */
+
+#include <vector>
+
+#include "expr/node_manager.h"
+#include "expr/node_signature_table.h"
+#include "expr/skolem_manager.h"
+#include "test_node.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+
+namespace test {
+
+class TestNodeBlackNodeSignatureTable : public TestNode
+{
+};
+
+TEST_F(TestNodeBlackNodeSignatureTable, add_or_get_term)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  TypeNode fType = d_nodeManager->mkFunctionType({intType, intType}, intType);
+  TypeNode gType = d_nodeManager->mkFunctionType(intType, intType);
+  Node f = d_skolemManager->mkDummySkolem("f", fType);
+  Node g = d_skolemManager->mkDummySkolem("g", gType);
+  Node a = d_skolemManager->mkDummySkolem("a", intType);
+  Node b = d_skolemManager->mkDummySkolem("b", intType);
+  Node fab = d_nodeManager->mkNode(APPLY_UF, f, a, b);
+  Node fba = d_nodeManager->mkNode(APPLY_UF, f, b, a);
+  Node fbb = d_nodeManager->mkNode(APPLY_UF, f, b, b);
+  Node ga = d_nodeManager->mkNode(APPLY_UF, g, a);
+
+  NodeSignatureTable table;
+  ASSERT_TRUE(table.empty());
+  ASSERT_EQ(table.addOrGetTerm(fab, f, {a, b}), fab);
+  ASSERT_EQ(table.addOrGetTerm(fba, f, {b, a}), fba);
+  ASSERT_EQ(table.addOrGetTerm(ga, g, {a}), ga);
+  ASSERT_EQ(table.size(), 3);
+  // suppose b = a, then f(b,b) is congruent to f(a,b)
+  ASSERT_EQ(table.addOrGetTerm(fbb, f, {a, b}), fab);
+  ASSERT_EQ(table.size(), 3);
+
+  ASSERT_EQ(table.existsTerm(f, {b, a}), fba);
+  ASSERT_EQ(table.existsTerm(g, {a}), ga);
+  ASSERT_TRUE(table.existsTerm(g, {b}).isNull());
+  ASSERT_TRUE(table.existsTerm(f, {a}).isNull());
+  ASSERT_TRUE(table.existsTerm(g, {a, b}).isNull());
+
+  table.clear();
+  ASSERT_TRUE(table.empty());
+  ASSERT_TRUE(table.existsTerm(f, {a, b}).isNull());
+}
+
+TEST_F(TestNodeBlackNodeSignatureTable, grow_and_clear)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  TypeNode gType = d_nodeManager->mkFunctionType(intType, intType);
+  Node g = d_skolemManager->mkDummySkolem("g", gType);
+  std::vector<Node> consts;
+  std::vector<Node> terms;
+  for (size_t i = 0; i < 100; i++)
+  {
+    consts.push_back(d_skolemManager->mkDummySkolem("c", intType));
+    terms.push_back(d_nodeManager->mkNode(APPLY_UF, g, consts.back()));
+  }
+
+  NodeSignatureTable table;
+  for (size_t i = 0; i < 100; i++)
+  {
+    ASSERT_EQ(table.addOrGetTerm(terms[i], g, {consts[i]}), terms[i]);
+  }
+  ASSERT_EQ(table.size(), 100);
+  for (size_t i = 0; i < 100; i++)
+  {
+    ASSERT_EQ(table.existsTerm(g, {consts[i]}), terms[i]);
+  }
+
+  // refill the table after clearing it
+  table.clear();
+  for (size_t i = 0; i < 100; i += 2)
+  {
+    ASSERT_EQ(table.addOrGetTerm(terms[i], g, {consts[i]}), terms[i]);
+  }
+  ASSERT_EQ(table.size(), 50);
+  for (size_t i = 0; i < 100; i++)
+  {
+    ASSERT_EQ(table.existsTerm(g, {consts[i]}).isNull(), i % 2 == 1);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the proof node manager.
+ */
+
+#include <memory>
+
+#include "options/options.h"
+#include "options/proof_options.h"
+#include "proof/proof_checker.h"
+#include "proof/proof_node.h"
+#include "proof/proof_node_algorithm.h"
+#include "proof/proof_node_manager.h"
+#include "smt/solver_engine_scope.h"
+#include "test_smt.h"
+
+namespace cvc5 {
+namespace test {
+
+class TestProofWhiteProofNodeManager : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SolverEngineScope(d_slvEngine.get()));
+    d_opts.proof.proofHashCons = true;
+    d_checker.reset(new ProofChecker(false));
+    d_pnm.reset(new ProofNodeManager(d_opts, nullptr, d_checker.get()));
+    TypeNode boolType = d_nodeManager->booleanType();
+    Node x = d_nodeManager->mkVar("x", boolType);
+    Node y = d_nodeManager->mkVar("y", boolType);
+    d_eq = x.eqNode(y);
+    d_eqSym = y.eqNode(x);
+  }
+
+  void TearDown() override
+  {
+    d_pnm.reset();
+    d_checker.reset();
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  std::unique_ptr<smt::SolverEngineScope> d_scope;
+  Options d_opts;
+  std::unique_ptr<ProofChecker> d_checker;
+  std::unique_ptr<ProofNodeManager> d_pnm;
+  Node d_eq;
+  Node d_eqSym;
+};
+
+TEST_F(TestProofWhiteProofNodeManager, hash_cons_assume)
+{
+  // two proofs of (= y x) from the assumption (= x y)
+  std::shared_ptr<ProofNode> pf1 =
+      d_pnm->mkNode(PfRule::SYMM, {d_pnm->mkAssume(d_eq)}, {}, d_eqSym);
+  std::shared_ptr<ProofNode> pf2 =
+      d_pnm->mkNode(PfRule::SYMM, {d_pnm->mkAssume(d_eq)}, {}, d_eqSym);
+  ASSERT_NE(pf1->getChildren()[0], pf2->getChildren()[0]);
+  // close the assumption in the first proof only
+  std::shared_ptr<ProofNode> pfEq =
+      d_pnm->mkNode(PfRule::MACRO_SR_PRED_INTRO, {}, {d_eq}, d_eq);
+  ASSERT_TRUE(d_pnm->updateNode(pf1->getChildren()[0].get(), pfEq.get()));
+  ASSERT_FALSE(expr::containsAssumption(pf1.get()));
+  ASSERT_TRUE(expr::containsAssumption(pf2.get()));
+}
+
+TEST_F(TestProofWhiteProofNodeManager, hash_cons_update)
+{
+  std::shared_ptr<ProofNode> pf1 =
+      d_pnm->mkNode(PfRule::MACRO_SR_PRED_INTRO, {}, {d_eq}, d_eq);
+  std::shared_ptr<ProofNode> pf2 =
+      d_pnm->mkNode(PfRule::MACRO_SR_PRED_INTRO, {}, {d_eq}, d_eq);
+  ASSERT_EQ(pf1, pf2);
+  // the shared node cannot be updated to a proof with a free assumption
+  std::shared_ptr<ProofNode> pfSym = d_pnm->mkAssume(d_eqSym);
+  ASSERT_FALSE(d_pnm->updateNode(pf1.get(), PfRule::SYMM, {pfSym}, {}));
+  ASSERT_FALSE(expr::containsAssumption(pf2.get()));
+  // updates that do not add free assumptions are allowed
+  ASSERT_TRUE(d_pnm->updateNode(pf1.get(), PfRule::TRUST_REWRITE, {}, {d_eq}));
+  ASSERT_EQ(pf2->getRule(), PfRule::TRUST_REWRITE);
+}
+
+TEST_F(TestProofWhiteProofNodeManager, hash_cons_update_assume)
+{
+  std::shared_ptr<ProofNode> a = d_pnm->mkAssume(d_eq);
+  std::shared_ptr<ProofNode> pf1 =
+      d_pnm->mkNode(PfRule::SYMM, {a}, {}, d_eqSym);
+  std::shared_ptr<ProofNode> pf2 =
+      d_pnm->mkNode(PfRule::SYMM, {a}, {}, d_eqSym);
+  ASSERT_EQ(pf1, pf2);
+  ASSERT_EQ(pf1->d_sharedAssumps, nullptr);
+  // updates using the same free assumption are allowed
+  std::shared_ptr<ProofNode> pfOther =
+      d_pnm->mkNode(PfRule::SYMM, {d_pnm->mkAssume(d_eq)}, {}, d_eqSym);
+  ASSERT_TRUE(d_pnm->updateNode(pf1.get(), pfOther.get()));
+  // the free assumptions of the shared node are cached
+  ASSERT_NE(pf1->d_sharedAssumps, nullptr);
+  ASSERT_EQ(pf1->d_sharedAssumps->size(), 1);
+  ASSERT_EQ(pf1->d_sharedAssumps->count(d_eq), 1);
+  // updates adding other free assumptions are rejected
+  std::shared_ptr<ProofNode> b = d_pnm->mkAssume(d_eqSym);
+  ASSERT_FALSE(d_pnm->updateNode(pf1.get(), b.get()));
+  ASSERT_EQ(pf1->getRule(), PfRule::SYMM);
+}
+
+TEST_F(TestProofWhiteProofNodeManager, ensure_checked_dag)
+{
+  d_checker->registerTrustedChecker(PfRule::SYMM, nullptr, 0);
+  d_checker->registerTrustedChecker(PfRule::AND_INTRO, nullptr, 0);
+  std::shared_ptr<ProofNode> a = d_pnm->mkAssume(d_eq);
+  std::shared_ptr<ProofNode> pf1 =
+      d_pnm->mkNode(PfRule::SYMM, {a}, {}, d_eqSym);
+  std::shared_ptr<ProofNode> pf2 =
+      d_pnm->mkNode(PfRule::SYMM, {a}, {}, d_eqSym);
+  ASSERT_EQ(pf1, pf2);
+  Node conj = d_nodeManager->mkNode(kind::AND, d_eqSym, d_eqSym);
+  std::shared_ptr<ProofNode> pf =
+      d_pnm->mkNode(PfRule::AND_INTRO, {pf1, pf2}, {}, conj);
+  // the proofs are not checked during construction in lazy mode
+  ASSERT_FALSE(pf->d_provenChecked);
+  // the shared subproof and the assumption are checked once
+  ASSERT_EQ(d_pnm->ensureCheckedDag(pf.get()), 3);
+  ASSERT_TRUE(pf1->d_provenChecked);
+  ASSERT_TRUE(a->d_provenChecked);
+  // checked proof nodes are not checked again
+  ASSERT_EQ(d_pnm->ensureCheckedDag(pf.get()), 0);
+}
+
+}  // namespace test
+}  // namespace cvc5
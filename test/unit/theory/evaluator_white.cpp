@@ -22,6 +22,7 @@
 #include "test_smt.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/evaluator.h"
+#include "theory/quantifiers/sygus/columnar_evaluator.h"
 #include "theory/rewriter.h"
 #include "util/rational.h"
 
@@ -160,5 +161,129 @@ TEST_F(TestTheoryWhiteEvaluator, code)
     ASSERT_EQ(r, d_nodeManager->mkConst(CONST_RATIONAL, Rational(-1)));
   }
 }
+
+TEST_F(TestTheoryWhiteEvaluator, columnar)
+{
+  TypeNode bv8Type = d_nodeManager->mkBitVectorType(8);
+  TypeNode intType = d_nodeManager->integerType();
+
+  Node x = d_nodeManager->mkVar("x", bv8Type);
+  Node y = d_nodeManager->mkVar("y", bv8Type);
+  Node i = d_nodeManager->mkVar("i", intType);
+  std::vector<Node> args = {x, y, i};
+
+  quantifiers::ColumnarEvaluator ceval(args);
+  std::vector<std::vector<Node>> examples;
+  std::vector<uint32_t> bvVals = {0, 1, 7, 8, 127, 128, 200, 255};
+  for (size_t j = 0, nvals = bvVals.size(); j < nvals; j++)
+  {
+    uint32_t k = bvVals[nvals - 1 - j];
+    examples.push_back({d_nodeManager->mkConst(BitVector(8, bvVals[j])),
+                        d_nodeManager->mkConst(BitVector(8, k)),
+                        d_nodeManager->mkConstInt(Rational(k) - 100)});
+    ceval.addExample(examples.back());
+  }
+  ASSERT_EQ(ceval.getNumExamples(), bvVals.size());
+
+  Node one = d_nodeManager->mkConstInt(Rational(1));
+  std::vector<Node> terms = {
+      d_nodeManager->mkNode(BITVECTOR_ADD, x, y),
+      d_nodeManager->mkNode(BITVECTOR_SUB, x, y),
+      d_nodeManager->mkNode(BITVECTOR_MULT, x, y, x),
+      d_nodeManager->mkNode(BITVECTOR_NEG, x),
+      d_nodeManager->mkNode(BITVECTOR_UDIV, x, y),
+      d_nodeManager->mkNode(BITVECTOR_UREM, x, y),
+      d_nodeManager->mkNode(BITVECTOR_SHL, x, y),
+      d_nodeManager->mkNode(BITVECTOR_LSHR, x, y),
+      d_nodeManager->mkNode(BITVECTOR_ASHR, x, y),
+      d_nodeManager->mkNode(BITVECTOR_SLT, x, y),
+      d_nodeManager->mkNode(BITVECTOR_UGE, x, y),
+      d_nodeManager->mkNode(BITVECTOR_COMP, x, y),
+      d_nodeManager->mkNode(
+          ITE, d_nodeManager->mkNode(BITVECTOR_SLE, x, y), x, y),
+      d_nodeManager->mkNode(PLUS, i, i, one),
+      d_nodeManager->mkNode(MULT, i, i),
+      d_nodeManager->mkNode(MINUS, one, i),
+      d_nodeManager->mkNode(ABS, i),
+      d_nodeManager->mkNode(AND,
+                            d_nodeManager->mkNode(LEQ, i, one),
+                            d_nodeManager->mkNode(EQUAL, x, y).notNode())};
+
+  Rewriter* rr = d_slvEngine->getRewriter();
+  for (const Node& t : terms)
+  {
+    quantifiers::Column col;
+    ASSERT_TRUE(ceval.evaluate(t, col));
+    ASSERT_EQ(col.d_vals.size(), examples.size());
+    for (size_t j = 0, nex = examples.size(); j < nex; j++)
+    {
+      const std::vector<Node>& ex = examples[j];
+      ASSERT_EQ(col.toNode(j),
+                rr->rewrite(t.substitute(
+                    args.begin(), args.end(), ex.begin(), ex.end())));
+    }
+  }
+
+  // unsupported operators
+  quantifiers::Column col;
+  ASSERT_FALSE(
+      ceval.evaluate(d_nodeManager->mkNode(INTS_DIVISION, i, i), col));
+  ASSERT_FALSE(ceval.evaluate(bv::utils::mkExtract(x, 3, 0), col));
+}
+
+TEST_F(TestTheoryWhiteEvaluator, program)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  TypeNode realType = d_nodeManager->realType();
+  TypeNode bv8Type = d_nodeManager->mkBitVectorType(8);
+
+  Node x = d_nodeManager->mkVar("x", intType);
+  Node r = d_nodeManager->mkVar("r", realType);
+  Node b = d_nodeManager->mkVar("b", bv8Type);
+  std::vector<Node> args = {x, r, b};
+
+  Node one = d_nodeManager->mkConstInt(Rational(1));
+  Node two = d_nodeManager->mkConstInt(Rational(2));
+  Node bvOne = d_nodeManager->mkConst(BitVector(8, 1u));
+  // the subterm (+ 1 2) does not depend on the variables
+  Node sum = d_nodeManager->mkNode(PLUS,
+                                   x,
+                                   d_nodeManager->mkNode(MULT, x, x),
+                                   d_nodeManager->mkNode(PLUS, one, two));
+  Node t = d_nodeManager->mkNode(
+      ITE,
+      d_nodeManager->mkNode(LT, sum, d_nodeManager->mkNode(DIVISION, one, r)),
+      d_nodeManager->mkNode(BITVECTOR_ADD, b, bvOne),
+      d_nodeManager->mkNode(BITVECTOR_SHL, b, bvOne));
+
+  Rewriter* rr = d_slvEngine->getRewriter();
+  Evaluator eval(rr);
+  EvaluatorProgram prog(eval, t, args);
+  ASSERT_TRUE(prog.isCompiled());
+  ASSERT_EQ(prog.getTerm(), t);
+  for (int i = -3; i <= 3; i++)
+  {
+    // r = 0 is a division by zero, where the program falls back to the
+    // evaluator
+    for (int j = 0; j <= 2; j++)
+    {
+      std::vector<Node> vals = {
+          d_nodeManager->mkConstInt(Rational(i)),
+          d_nodeManager->mkConstReal(Rational(j, 2)),
+          d_nodeManager->mkConst(BitVector(8, static_cast<uint32_t>(i * 50)))};
+      ASSERT_EQ(prog.eval(vals), eval.eval(t, args, vals));
+    }
+  }
+
+  // terms with applications of uninterpreted functions are not compiled
+  Node f = d_nodeManager->mkVar(
+      "f", d_nodeManager->mkFunctionType(intType, intType));
+  Node ft = d_nodeManager->mkNode(
+      PLUS, d_nodeManager->mkNode(APPLY_UF, f, x), one);
+  EvaluatorProgram fprog(eval, ft, args);
+  ASSERT_FALSE(fprog.isCompiled());
+  std::vector<Node> vals = {two, one, bvOne};
+  ASSERT_EQ(fprog.eval(vals), eval.eval(ft, args, vals));
+}
 }  // namespace test
 }  // namespace cvc5
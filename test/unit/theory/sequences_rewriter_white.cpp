@@ -17,12 +17,14 @@
 #include <memory>
 #include <vector>
 
+#include "base/configuration.h"
 #include "expr/node.h"
 #include "expr/node_manager.h"
 #include "test_smt.h"
 #include "theory/rewriter.h"
 #include "theory/strings/arith_entail.h"
 #include "theory/strings/sequences_rewriter.h"
+#include "theory/strings/sequences_stats.h"
 #include "theory/strings/strings_entail.h"
 #include "theory/strings/strings_rewriter.h"
 #include "util/rational.h"
@@ -140,6 +142,39 @@ TEST_F(TestTheoryWhiteSequencesRewriter, check_entail_arith)
   ASSERT_FALSE(ae.check(substr_z, one));
 }
 
+TEST_F(TestTheoryWhiteSequencesRewriter, check_entail_arith_cache)
+{
+  smt::SolverEngineScope scope(d_slvEngine.get());
+  SequencesStatistics stats;
+  SequencesRewriter seqRewriter(d_rewriter, &stats);
+  ArithEntail& ae = seqRewriter.getArithEntail();
+  TypeNode strType = d_nodeManager->stringType();
+
+  Node x = d_nodeManager->mkVar("x", strType);
+  Node lenx = d_nodeManager->mkNode(kind::STRING_LENGTH, x);
+  Node zero = d_nodeManager->mkConst(CONST_RATIONAL, Rational(0));
+
+  // repeated checks are answered by the cache, where strict and non-strict
+  // entailments are cached separately
+  int64_t hits = 0;
+  int64_t misses = 0;
+  for (size_t i = 0; i < 2; i++)
+  {
+    hits = stats.d_entailCacheHits.get();
+    misses = stats.d_entailCacheMisses.get();
+    ASSERT_TRUE(ae.check(lenx, zero));
+    ASSERT_FALSE(ae.check(lenx, zero, true));
+    ASSERT_TRUE(ae.check(lenx));
+    ASSERT_FALSE(ae.check(lenx, true));
+    ASSERT_FALSE(ae.check(zero, lenx, true));
+  }
+  if constexpr (configuration::isStatisticsBuild())
+  {
+    ASSERT_EQ(stats.d_entailCacheHits.get(), hits + 5);
+    ASSERT_EQ(stats.d_entailCacheMisses.get(), misses);
+  }
+}
+
 TEST_F(TestTheoryWhiteSequencesRewriter, check_entail_with_with_assumption)
 {
   ArithEntail& ae = d_seqRewriter->getArithEntail();
@@ -24,6 +24,7 @@
 #include "test_smt.h"
 #include "theory/arith/nl/cad/cdcac.h"
 #include "theory/arith/nl/cad/lazard_evaluation.h"
+#include "theory/arith/nl/cad/projection_cache.h"
 #include "theory/arith/nl/cad/projections.h"
 #include "theory/arith/nl/cad_solver.h"
 #include "theory/arith/nl/nl_lemma_utils.h"
@@ -165,6 +166,41 @@ TEST_F(TestTheoryWhiteArithCAD, test_projection)
                 - 7 * x - 14);
 }
 
+TEST_F(TestTheoryWhiteArithCAD, test_projection_cache)
+{
+  Options opts;
+  Env env(NodeManager::currentNM(), &opts);
+  cad::ProjectionCache cache(env.getStatisticsRegistry());
+  poly::Variable x("x");
+  poly::Variable y("y");
+
+  poly::Polynomial p = (y + 1) * (y + 1) - x * x * x + 3 * x - 2;
+  poly::Polynomial q = (x + 1) * y - 3;
+
+  const poly::Polynomial& disc = cache.discriminant(p);
+  EXPECT_EQ(disc, discriminant(p));
+  EXPECT_EQ(&disc, &cache.discriminant(p));
+  const poly::Polynomial& res = cache.resultant(p, q);
+  EXPECT_EQ(res, resultant(p, q));
+  EXPECT_EQ(&res, &cache.resultant(p, q));
+
+  size_t computed = 0;
+  auto compute = [&computed]() {
+    ++computed;
+    return std::vector<poly::Value>{poly::Value(poly::Integer(1))};
+  };
+  cad::ProjectionCache::AssignmentKey key1{q, {poly::Value(poly::Integer(1))}};
+  cad::ProjectionCache::AssignmentKey key2{q, {poly::Value(poly::Integer(2))}};
+  cache.realRoots(key1, compute);
+  cache.realRoots(key1, compute);
+  EXPECT_EQ(computed, 1);
+  cache.realRoots(key2, compute);
+  EXPECT_EQ(computed, 2);
+  cache.clear();
+  cache.realRoots(key1, compute);
+  EXPECT_EQ(computed, 3);
+}
+
 poly::Polynomial up_to_poly(const poly::UPolynomial& p, poly::Variable var)
 {
   poly::Polynomial res;
@@ -19,6 +19,7 @@
 #include "context/context.h"
 #include "expr/node.h"
 #include "test_smt.h"
+#include "theory/arith/tableau.h"
 #include "theory/arith/theory_arith.h"
 #include "theory/quantifiers_engine.h"
 #include "theory/theory.h"
@@ -122,5 +123,52 @@ TEST_F(TestTheoryWhiteArith, int_normal_form)
           .eqNode(c0);
   ASSERT_EQ(Rewriter::rewrite(Rewriter::rewrite(t)), Rewriter::rewrite(t));
 }
+
+TEST_F(TestTheoryWhiteArith, tableau_compaction)
+{
+  NoEffectCCCB cb;
+  Tableau tab;
+  tab.increaseSizeTo(5);
+  // x3 = x0 + 2*x1, x4 = x1 - x2
+  tab.addRow(3, {Rational(1), Rational(2)}, {0, 1});
+  tab.addRow(4, {Rational(1), Rational(-1)}, {1, 2});
+  // x1 becomes basic, this introduces x0 and x3 into the row of x4
+  tab.pivot(3, 1, cb);
+  uint32_t entries = tab.size();
+  ASSERT_EQ(tab.basicRowLength(1), 3);
+  ASSERT_EQ(tab.basicRowLength(4), 4);
+  Rational x4x0 = tab.basicFindEntry(4, 0).getCoefficient();
+  Rational x4x3 = tab.basicFindEntry(4, 3).getCoefficient();
+
+  tab.compactEntries();
+  ASSERT_EQ(tab.size(), entries);
+  ASSERT_EQ(tab.getNumEntriesInTableau(), entries);
+  ASSERT_EQ(tab.basicRowLength(1), 3);
+  ASSERT_EQ(tab.basicRowLength(4), 4);
+  ASSERT_EQ(tab.basicFindEntry(4, 0).getCoefficient(), x4x0);
+  ASSERT_EQ(tab.basicFindEntry(4, 3).getCoefficient(), x4x3);
+  ASSERT_TRUE(tab.basicFindEntry(4, 1).blank());
+  // the entries of every row are stored contiguously
+  EntryID last = ENTRYID_SENTINEL;
+  for (Tableau::RowIterator i = tab.basicRowIterator(4); !i.atEnd(); ++i)
+  {
+    if (last != ENTRYID_SENTINEL)
+    {
+      ASSERT_EQ(i.getID(), last + 1);
+    }
+    last = i.getID();
+  }
+  // columns are still consistent with the rows
+  uint32_t colSum = 0;
+  for (ArithVar v = 0; v < 5; ++v)
+  {
+    for (Tableau::ColIterator i = tab.colIterator(v); !i.atEnd(); ++i)
+    {
+      ASSERT_EQ((*i).getColVar(), v);
+      ++colSum;
+    }
+  }
+  ASSERT_EQ(colSum, entries);
+}
 }  // namespace test
 }  // namespace cvc5
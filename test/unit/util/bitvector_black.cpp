@@ -14,6 +14,7 @@
  */
 
 #include <sstream>
+#include <vector>
 
 #include "test.h"
 #include "util/bitvector.h"
@@ -206,5 +207,58 @@ TEST_F(TestUtilBlackBitVector, static_helpers)
   ASSERT_EQ(BitVector::mkMinSigned(4).toSignedInteger(), Integer(-8));
   ASSERT_EQ(BitVector::mkMaxSigned(4).toSignedInteger(), Integer(7));
 }
+
+TEST_F(TestUtilBlackBitVector, word_boundaries)
+{
+  // Bit-vectors of size at most 64 are computed on machine words, check that
+  // they agree with the same operations on (zero or sign) extensions to 128
+  // bits, which are computed on Integers.
+  for (unsigned size : {1u, 7u, 63u, 64u, 65u})
+  {
+    std::vector<BitVector> vals = {BitVector::mkZero(size),
+                                   BitVector::mkOne(size),
+                                   BitVector::mkOnes(size),
+                                   BitVector::mkMinSigned(size),
+                                   BitVector::mkMaxSigned(size),
+                                   BitVector(size, Integer(size)),
+                                   BitVector(size, Integer(-12345678901))};
+    unsigned n = 128 - size;
+    for (const BitVector& a : vals)
+    {
+      BitVector za = a.zeroExtend(n);
+      BitVector sa = a.signExtend(n);
+      ASSERT_EQ(a.toSignedInteger(), sa.toSignedInteger());
+      ASSERT_EQ(a.toString(), za.extract(size - 1, 0).toString());
+      ASSERT_EQ(-a, (-za).extract(size - 1, 0));
+      ASSERT_EQ(~a, (~za).extract(size - 1, 0));
+      for (const BitVector& b : vals)
+      {
+        BitVector zb = b.zeroExtend(n);
+        BitVector sb = b.signExtend(n);
+        ASSERT_EQ(a + b, (za + zb).extract(size - 1, 0));
+        ASSERT_EQ(a - b, (za - zb).extract(size - 1, 0));
+        ASSERT_EQ(a * b, (za * zb).extract(size - 1, 0));
+        ASSERT_EQ(a & b, (za & zb).extract(size - 1, 0));
+        ASSERT_EQ(a | b, (za | zb).extract(size - 1, 0));
+        ASSERT_EQ(a ^ b, (za ^ zb).extract(size - 1, 0));
+        ASSERT_EQ(a.unsignedLessThan(b), za.unsignedLessThan(zb));
+        ASSERT_EQ(a.unsignedLessThanEq(b), za.unsignedLessThanEq(zb));
+        ASSERT_EQ(a.signedLessThan(b), sa.signedLessThan(sb));
+        ASSERT_EQ(a.signedLessThanEq(b), sa.signedLessThanEq(sb));
+        ASSERT_EQ(a == b, za == zb);
+        ASSERT_EQ(a.unsignedDivTotal(b),
+                  za.unsignedDivTotal(zb).extract(size - 1, 0));
+        ASSERT_EQ(a.unsignedRemTotal(b),
+                  za.unsignedRemTotal(zb).extract(size - 1, 0));
+        ASSERT_EQ(a.leftShift(b), za.leftShift(zb).extract(size - 1, 0));
+        ASSERT_EQ(a.logicalRightShift(b),
+                  za.logicalRightShift(zb).extract(size - 1, 0));
+        ASSERT_EQ(a.arithRightShift(b),
+                  sa.arithRightShift(zb).extract(size - 1, 0));
+        ASSERT_EQ(a.concat(b).toString(), a.toString() + b.toString());
+      }
+    }
+  }
+}
 }  // namespace test
 }  // namespace cvc5
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::String.
+ */
+
+#include <vector>
+
+#include "test.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace test {
+
+class TestUtilBlackString : public TestInternal
+{
+ protected:
+  /** A string containing characters that do not fit into a byte */
+  String mkWide(const std::string& s)
+  {
+    std::vector<unsigned> vec = String(s).getVec();
+    for (unsigned& c : vec)
+    {
+      if (c == 'W')
+      {
+        c = 0x1000;
+      }
+    }
+    return String(vec);
+  }
+};
+
+TEST_F(TestUtilBlackString, code_points)
+{
+  std::vector<unsigned> vec{97, 255, 256, 0x2FFFF};
+  String s(vec);
+  ASSERT_EQ(s.size(), 4);
+  ASSERT_EQ(s.getVec(), vec);
+  ASSERT_EQ(s[1], 255);
+  ASSERT_EQ(s.front(), 97);
+  ASSERT_EQ(s.back(), 0x2FFFF);
+  ASSERT_EQ(String("a\\u{100}", true).back(), 256);
+}
+
+TEST_F(TestUtilBlackString, compare)
+{
+  String a("abc");
+  String w = mkWide("abW");
+  ASSERT_LT(a, w);
+  ASSERT_NE(a, w);
+  ASSERT_LT(String("ab"), a);
+  ASSERT_LT(String(std::vector<unsigned>{255}),
+            String(std::vector<unsigned>{256}));
+  // substrings without wide characters are equal to narrow strings
+  ASSERT_EQ(w.substr(0, 2), String("ab"));
+  ASSERT_EQ(w.prefix(2).concat(String("c")), a);
+  strings::StringHashFunction h;
+  ASSERT_EQ(h(w.substr(0, 2)), h(String("ab")));
+}
+
+TEST_F(TestUtilBlackString, find)
+{
+  String s = mkWide("abWabWab");
+  ASSERT_EQ(s.find(String("ab")), 0);
+  ASSERT_EQ(s.find(String("ab"), 1), 3);
+  ASSERT_EQ(s.find(mkWide("Wa")), 2);
+  ASSERT_EQ(s.find(mkWide("Wa"), 3), 5);
+  ASSERT_EQ(s.find(mkWide("WW")), std::string::npos);
+  ASSERT_EQ(s.rfind(String("ab")), 0);
+  ASSERT_EQ(s.rfind(String("ab"), 1), 3);
+  ASSERT_EQ(s.rfind(mkWide("bW")), 2);
+  ASSERT_EQ(String("abab").find(mkWide("W")), std::string::npos);
+  ASSERT_EQ(String("xabab").find(String("ab"), 2), 3);
+  ASSERT_EQ(String("xabab").rfind(String("ab"), 1), 2);
+}
+
+TEST_F(TestUtilBlackString, prefix_suffix)
+{
+  String s = mkWide("abWcd");
+  ASSERT_TRUE(s.hasPrefix(String("ab")));
+  ASSERT_TRUE(s.hasPrefix(mkWide("abW")));
+  ASSERT_FALSE(s.hasPrefix(String("abc")));
+  ASSERT_TRUE(s.hasSuffix(String("cd")));
+  ASSERT_TRUE(s.hasSuffix(mkWide("Wcd")));
+  ASSERT_FALSE(String("cd").hasSuffix(s));
+  ASSERT_TRUE(s.strncmp(String("abx"), 2));
+  ASSERT_TRUE(s.rstrncmp(String("xcd"), 2));
+  ASSERT_EQ(s.overlap(String("cde")), 2);
+  ASSERT_EQ(s.roverlap(String("xab")), 2);
+}
+
+TEST_F(TestUtilBlackString, update_replace)
+{
+  String s = mkWide("abWcd");
+  ASSERT_EQ(s.replace(mkWide("W"), String("x")), String("abxcd"));
+  ASSERT_EQ(s.update(2, String("xy")), String("abxyd"));
+  ASSERT_EQ(String("abcd").update(3, mkWide("WW")), mkWide("abcW"));
+}
+
+}  // namespace test
+}  // namespace cvc5